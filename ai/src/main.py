@@ -20,7 +20,7 @@ def parse_arguments():
     )
     parser.add_argument('-p', '--port', type=int, required=True, help='Port number')
     parser.add_argument('-n', '--name', type=str, required=True, help='Team name')
-    parser.add_argument('-h', '--host', type=str, default='localhost', help='Server hostname (default: localhost)')
+    parser.add_argument('-h', '--host', type=str, default='localhost', help='Server hostname, or unix:<path> (default: localhost)')
     parser.add_argument('--help', action='help', help='Show this help message and exit')
     
     return parser.parse_args()
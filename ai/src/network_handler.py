@@ -25,10 +25,16 @@ class NetworkHandler:
         self.world_width = 0
         self.world_height = 0
         
-        # Network configuration
-        self.server_address = (host, port)
+        # Network configuration: "unix:<path>" selects a Unix socket
+        self.host = host
+        self.port = port
+        if host.startswith("unix:"):
+            self.server_address = host[len("unix:"):]
+            self.client_socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        else:
+            self.server_address = (host, port)
+            self.client_socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
         self.network_thread = threading.Thread(target=self._network_task)
-        self.client_socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
         self.available_slots = 0
         
         # Thread synchronization
@@ -47,7 +53,7 @@ class NetworkHandler:
         with self.data_lock:
             try:
                 self.client_socket.connect(self.server_address)
-            except ConnectionRefusedError:
+            except (ConnectionRefusedError, FileNotFoundError):
                 return
             
             # Receive welcome message
@@ -61,9 +67,7 @@ class NetworkHandler:
             self.available_slots, self.world_width, self.world_height = [int(x) for x in response.split()]
             
             # Initialize game logic
-            self.game_logic = GameLogic(
-                self.team_name, self.server_address[0], self.server_address[1]
-            )
+            self.game_logic = GameLogic(self.team_name, self.host, self.port)
             if self.available_slots >= 0:
                 self.is_connected = True
         
@@ -65,7 +65,8 @@ void LoginScreen::HandleInput() {
 
     int key = GetCharPressed();
     while (key > 0) {
-        if (m_hostInputActive && m_host.length() < 15) {
+        // Room for an IPv4 address or a short unix:<path>
+        if (m_hostInputActive && m_host.length() < 48) {
             if ((key >= 32) && (key <= 125)) {
                 m_host += (char)key;
             }
@@ -1,5 +1,6 @@
 #include "Network.hpp"
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
@@ -14,7 +15,27 @@ Network::~Network() {
 }
 
 bool Network::Connect(const std::string& host, int port) {
-    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    // "unix:<path>" connects to the server's Unix socket, port is unused
+    bool local = host.compare(0, 5, "unix:") == 0;
+    struct sockaddr_storage addr = {};
+    socklen_t addrLen;
+
+    if (local) {
+        std::string path = host.substr(5);
+        struct sockaddr_un* un = (struct sockaddr_un*)&addr;
+        if (path.size() >= sizeof(un->sun_path)) return false;
+        un->sun_family = AF_UNIX;
+        memcpy(un->sun_path, path.c_str(), path.size() + 1);
+        addrLen = sizeof(struct sockaddr_un);
+    } else {
+        struct sockaddr_in* in = (struct sockaddr_in*)&addr;
+        in->sin_family = AF_INET;
+        in->sin_port = htons(port);
+        inet_pton(AF_INET, host.c_str(), &in->sin_addr);
+        addrLen = sizeof(struct sockaddr_in);
+    }
+
+    m_socket = socket(local ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
     if (m_socket < 0) return false;
     
     struct timeval timeout;
@@ -22,13 +43,9 @@ bool Network::Connect(const std::string& host, int port) {
     timeout.tv_usec = 0;
     setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
     
-    struct sockaddr_in addr;
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
-    
-    if (connect(m_socket, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    if (connect(m_socket, (struct sockaddr*)&addr, addrLen) < 0) {
         close(m_socket);
+        m_socket = -1;
         return false;
     }
     
@@ -12,7 +12,7 @@
 void printUsage(const char* program) {
     std::cout << "USAGE: " << program << " [-p port] [-h machine]\n";
     std::cout << "       -p port     port number (optional, can use login screen)\n";
-    std::cout << "       -h machine  hostname of the server (optional, can use login screen)\n";
+    std::cout << "       -h machine  hostname of the server, or unix:<path> (optional, can use login screen)\n";
     std::cout << "\nIf no parameters are provided, the login screen will be shown.\n";
     std::cout << "Parameters override the login screen and connect directly.\n";
 }
@@ -0,0 +1,40 @@
+#!/bin/sh
+##
+## EPITECH PROJECT, 2025
+## zappy_server
+## File description:
+## Syscalls per command under each event backend
+##
+
+# Runs the server under the syscount shim with each backend, drives it
+# with bench_load and prints the server's syscalls per command.
+#
+#   bench/backends.sh [bots] [guis] [seconds] [freq]
+#
+# Run from server/ after make bench.
+
+BOTS=${1:-200}
+GUIS=${2:-0}
+SECONDS_RUN=${3:-5}
+FREQ=${4:-10000}
+PORT=${PORT:-4343}
+LOG=$(mktemp)
+
+for backend in poll epoll uring; do
+    LD_PRELOAD=./bin/syscount.so ./bin/zappy_server -p "$PORT" -x 50 -y 50 \
+        -n bench -c 100000 -f "$FREQ" -e "$backend" >/dev/null 2>"$LOG" &
+    server=$!
+    sleep 0.5
+    result=$(./bin/bench_load -p "$PORT" -n bench -b "$BOTS" -g "$GUIS" -d "$SECONDS_RUN")
+    kill -INT "$server"
+    wait "$server"
+
+    commands=$(echo "$result" | sed -n 's/.* \([0-9]*\) commands,.*/\1/p')
+    lines=$(echo "$result" | sed -n 's/.*, \([0-9]*\) replies.*, \([0-9]*\) gui lines.*/\1 \2/p')
+    total=$(sed -n 's/^syscount:.* total \([0-9]*\)$/\1/p' "$LOG")
+    echo "$backend: $result"
+    echo "$lines" | awk -v total="$total" -v commands="$commands" -v backend="$backend" \
+        '{ printf "%s: %s syscalls, %.4f per command, %.4f per reply line\n",
+           backend, total, total / commands, total / ($1 + $2) }'
+done
+rm -f "$LOG"
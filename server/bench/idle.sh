@@ -0,0 +1,32 @@
+#!/bin/sh
+##
+## EPITECH PROJECT, 2025
+## zappy_server
+## File description:
+## Round trip of one active client among idle connections
+##
+
+# For poll and epoll, runs one bot sending Connect_nbr, an immediate
+# command, one at a time beside 100, 500 and 1000 idle connections,
+# and prints its round trips.
+#
+#   bench/idle.sh [seconds]
+#
+# Run from server/ after make bench.
+
+SECONDS_RUN=${1:-3}
+PORT=${PORT:-4344}
+
+for backend in poll epoll; do
+    for idle in 100 500 1000; do
+        ./bin/zappy_server -p "$PORT" -x 10 -y 10 -n bench -c 1000 -f 10000 \
+            -e "$backend" >/dev/null 2>&1 &
+        server=$!
+        sleep 0.5
+        result=$(./bin/bench_load -p "$PORT" -n bench -b 1 -i "$idle" -d "$SECONDS_RUN" \
+            -m Connect_nbr -r)
+        kill -INT "$server"
+        wait "$server"
+        echo "$backend, $idle idle: $(echo "$result" | sed -n 's/^round trip: //p')"
+    done
+done
@@ -0,0 +1,369 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Load generator: AI bots, GUIs and idle connections
+*/
+
+// Bots join a team and keep a window of AI commands in flight; a dead
+// bot reconnects and joins again while the team has slots. GUIs send a
+// bct/ppo/sgt burst every 10 ms. Idle connections only say hello.
+//
+//   bench_load -p port [-u path] -n team [-b bots] [-g guis] [-i idle]
+//              [-q depth] [-d seconds] [-m command] [-r]
+//
+// -m sends that one command instead of the mix. -r measures round
+// trips: each bot keeps one command in flight and the reply latencies
+// are reported as percentiles; with an immediate command such as
+// Connect_nbr they leave out the action durations.
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <getopt.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define LINE_MAX_SIZE 8192
+#define GUI_PERIOD_US 10000
+#define SAMPLES_MAX (1 << 22)
+#define COMMAND_MAX 256
+#define DEPTH_MAX 10  // the server queues at most MAX_COMMANDS
+
+typedef enum {
+    CONN_BOT,
+    CONN_GUI,
+    CONN_IDLE
+} conn_kind_t;
+
+typedef enum {
+    STAGE_WELCOME,   // waiting for WELCOME
+    STAGE_SLOTS,     // waiting for the join reply
+    STAGE_SIZE,      // waiting for the map size, when sent on its own line
+    STAGE_RUNNING
+} conn_stage_t;
+
+typedef struct conn_s {
+    int fd;
+    conn_kind_t kind;
+    conn_stage_t stage;
+    int inflight;
+    int next_command;
+    uint64_t sent_at[16];  // send time of each command in flight, FIFO
+    int sent_head;
+    char in[LINE_MAX_SIZE];
+    size_t in_size;
+} conn_t;
+
+static const char *commands[] = {
+    "Forward\n", "Right\n", "Look\n", "Inventory\n",
+    "Take food\n", "Left\n", "Broadcast bench\n", "Take food\n"
+};
+#define COMMAND_COUNT (int)(sizeof(commands) / sizeof(commands[0]))
+
+static const char *team = NULL;
+static uint16_t port = 0;
+static const char *unix_path = NULL;
+static int depth = 8;
+static int rtt_mode = 0;
+static char fixed_command[COMMAND_MAX];
+
+static uint64_t commands_sent;
+static uint64_t replies;
+static uint64_t events;
+static uint64_t gui_lines;
+static uint64_t deaths;
+static uint64_t rejected;
+static uint64_t *samples;
+static size_t sample_count;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int connect_server(void)
+{
+    int fd;
+
+    if (unix_path) {
+        struct sockaddr_un addr = {0};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, unix_path, sizeof(addr.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) goto fail;
+    } else {
+        struct sockaddr_in addr = {0};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) goto fail;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+fail:
+    perror("connect");
+    if (fd >= 0) close(fd);
+    return -1;
+}
+
+static void send_all(int fd, const char *data, size_t len)
+{
+    while (len > 0) {
+        ssize_t sent = send(fd, data, len, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += sent;
+        len -= sent;
+    }
+}
+
+static void bot_fill(conn_t *conn)
+{
+    char batch[DEPTH_MAX * COMMAND_MAX];
+    size_t len = 0;
+    int window = rtt_mode ? 1 : depth;
+
+    while (conn->inflight < window) {
+        const char *command = fixed_command[0] ? fixed_command :
+            commands[conn->next_command++ % COMMAND_COUNT];
+        size_t size = strlen(command);
+        memcpy(batch + len, command, size);
+        len += size;
+        conn->sent_at[(conn->sent_head + conn->inflight) % 16] = now_us();
+        conn->inflight++;
+        commands_sent++;
+    }
+    if (len > 0) send_all(conn->fd, batch, len);
+}
+
+static void gui_burst(conn_t *conn)
+{
+    static const char burst[] = "bct 0 0\nppo #1\nsgt\nbct 1 1\n";
+
+    send_all(conn->fd, burst, sizeof(burst) - 1);
+}
+
+static int conn_open(conn_t *conn, conn_kind_t kind, int epoll_fd)
+{
+    memset(conn, 0, sizeof(*conn));
+    conn->kind = kind;
+    conn->fd = connect_server();
+    if (conn->fd < 0) return -1;
+
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = conn};
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, conn->fd, &ev);
+}
+
+static void conn_close(conn_t *conn)
+{
+    if (conn->fd >= 0) close(conn->fd);
+    conn->fd = -1;
+}
+
+// One complete line from the server; false to drop the connection
+static bool handle_line(conn_t *conn, const char *line, int epoll_fd)
+{
+    switch (conn->stage) {
+    case STAGE_WELCOME:
+        if (strcmp(line, "WELCOME") != 0) return false;
+        conn->stage = STAGE_SLOTS;
+        if (conn->kind == CONN_GUI) {
+            send_all(conn->fd, "GRAPHIC\n", 8);
+            conn->stage = STAGE_RUNNING;
+        } else if (conn->kind == CONN_BOT) {
+            char join[256];
+            int len = snprintf(join, sizeof(join), "%s\n", team);
+            send_all(conn->fd, join, len);
+        }
+        return true;
+    case STAGE_SLOTS:
+        if (strcmp(line, "ko") == 0 || strcmp(line, "0") == 0) {
+            rejected++;
+            return false;
+        }
+        // "slots width height" on one line, or the size on the next
+        if (!strchr(line, ' ')) {
+            conn->stage = STAGE_SIZE;
+            return true;
+        }
+        conn->stage = STAGE_RUNNING;
+        bot_fill(conn);
+        return true;
+    case STAGE_SIZE:
+        conn->stage = STAGE_RUNNING;
+        bot_fill(conn);
+        return true;
+    case STAGE_RUNNING:
+        break;
+    }
+
+    if (conn->kind == CONN_GUI) {
+        gui_lines++;
+        return true;
+    }
+
+    // Events interleave with replies and answer no command
+    if (strncmp(line, "message ", 8) == 0 || strncmp(line, "eject:", 6) == 0 ||
+        strcmp(line, "Elevation underway") == 0) {
+        events++;
+        return true;
+    }
+    if (strcmp(line, "dead") == 0) {
+        deaths++;
+        conn_close(conn);
+        return conn_open(conn, CONN_BOT, epoll_fd) == 0;
+    }
+
+    replies++;
+    if (conn->inflight > 0) {
+        uint64_t sent_at = conn->sent_at[conn->sent_head];
+        conn->sent_head = (conn->sent_head + 1) % 16;
+        conn->inflight--;
+        if (rtt_mode && sample_count < SAMPLES_MAX) {
+            samples[sample_count++] = now_us() - sent_at;
+        }
+    }
+    bot_fill(conn);
+    return true;
+}
+
+static bool conn_read(conn_t *conn, int epoll_fd)
+{
+    ssize_t received = recv(conn->fd, conn->in + conn->in_size,
+                            sizeof(conn->in) - conn->in_size, 0);
+    if (received <= 0) return false;
+    conn->in_size += received;
+
+    size_t start = 0;
+    char *newline;
+    while ((newline = memchr(conn->in + start, '\n', conn->in_size - start))) {
+        *newline = '\0';
+        if (!handle_line(conn, conn->in + start, epoll_fd)) return false;
+        // A dead bot came back on a new socket with an empty buffer
+        if (conn->in_size == 0) return true;
+        start = newline - conn->in + 1;
+    }
+    memmove(conn->in, conn->in + start, conn->in_size - start);
+    conn->in_size -= start;
+    if (conn->in_size == sizeof(conn->in)) conn->in_size = 0;
+    return true;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void print_usage(const char *prog)
+{
+    fprintf(stderr, "USAGE: %s -p port [-u path] -n team [-b bots] [-g guis] "
+            "[-i idle] [-q depth] [-d seconds] [-m command] [-r]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    int bots = 100;
+    int guis = 0;
+    int idle = 0;
+    double duration = 5.0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:u:n:b:g:i:q:d:m:r")) != -1) {
+        switch (opt) {
+        case 'p': port = atoi(optarg); break;
+        case 'u': unix_path = optarg; break;
+        case 'n': team = optarg; break;
+        case 'b': bots = atoi(optarg); break;
+        case 'g': guis = atoi(optarg); break;
+        case 'i': idle = atoi(optarg); break;
+        case 'q': depth = atoi(optarg); break;
+        case 'd': duration = atof(optarg); break;
+        case 'm':
+            // The newline must fit, or the line never ends
+            if (strlen(optarg) + 1 >= sizeof(fixed_command)) {
+                print_usage(argv[0]);
+                return 84;
+            }
+            snprintf(fixed_command, sizeof(fixed_command), "%s\n", optarg);
+            break;
+        case 'r': rtt_mode = 1; break;
+        default: print_usage(argv[0]); return 84;
+        }
+    }
+    if ((!port && !unix_path) || (bots > 0 && !team) || depth < 1 || depth > DEPTH_MAX) {
+        print_usage(argv[0]);
+        return 84;
+    }
+
+    int total = bots + guis + idle;
+    conn_t *conns = calloc(total, sizeof(conn_t));
+    struct epoll_event *ready = calloc(total + 1, sizeof(struct epoll_event));
+    samples = rtt_mode ? malloc(SAMPLES_MAX * sizeof(uint64_t)) : NULL;
+    int epoll_fd = epoll_create1(0);
+    if (!conns || !ready || (rtt_mode && !samples) || epoll_fd < 0) return 84;
+
+    for (int i = 0; i < total; i++) {
+        conn_kind_t kind = i < bots ? CONN_BOT : i < bots + guis ? CONN_GUI : CONN_IDLE;
+        if (conn_open(&conns[i], kind, epoll_fd) < 0) return 84;
+    }
+
+    uint64_t start = now_us();
+    uint64_t end = start + (uint64_t)(duration * 1e6);
+    uint64_t next_burst = start;
+    uint64_t now;
+
+    while ((now = now_us()) < end) {
+        if (guis > 0 && now >= next_burst) {
+            for (int i = bots; i < bots + guis; i++) {
+                if (conns[i].fd >= 0 && conns[i].stage == STAGE_RUNNING) gui_burst(&conns[i]);
+            }
+            next_burst = now + GUI_PERIOD_US;
+        }
+        int timeout = guis > 0 ? (int)((next_burst - now) / 1000) : 100;
+        int count = epoll_wait(epoll_fd, ready, total + 1, timeout);
+        for (int i = 0; i < count; i++) {
+            conn_t *conn = ready[i].data.ptr;
+            if (conn->fd >= 0 && !conn_read(conn, epoll_fd)) conn_close(conn);
+        }
+    }
+
+    double seconds = (now_us() - start) / 1e6;
+    printf("%d bots, %d guis, %d idle, %.1f s: %llu commands, %llu replies "
+           "(%.0f/s), %llu events, %llu gui lines, %llu deaths, %llu rejected\n",
+           bots, guis, idle, seconds, (unsigned long long)commands_sent,
+           (unsigned long long)replies, replies / seconds, (unsigned long long)events,
+           (unsigned long long)gui_lines, (unsigned long long)deaths,
+           (unsigned long long)rejected);
+    if (rtt_mode && sample_count > 0) {
+        uint64_t sum = 0;
+        qsort(samples, sample_count, sizeof(uint64_t), compare_u64);
+        for (size_t i = 0; i < sample_count; i++) sum += samples[i];
+        printf("round trip: mean %.1f us, p50 %llu us, p99 %llu us, max %llu us\n",
+               (double)sum / sample_count,
+               (unsigned long long)samples[sample_count / 2],
+               (unsigned long long)samples[sample_count * 99 / 100],
+               (unsigned long long)samples[sample_count - 1]);
+    }
+    return 0;
+}
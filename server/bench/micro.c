@@ -0,0 +1,128 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Shared helpers for the in-process microbenchmarks
+*/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "micro.h"
+#include "client.h"
+#include "game.h"
+#include "scheduler.h"
+
+// The server objects refer to the instance main() creates
+server_t *g_server = NULL;
+
+static volatile uint64_t sink;
+
+uint64_t micro_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void micro_sink(uint64_t value)
+{
+    sink += value;
+}
+
+static client_t *micro_client(network_t *net, client_type_t type)
+{
+    client_t *client = client_create(-1);
+
+    client->type = type;
+    client->state = type == CLIENT_GUI ? STATE_CONNECTED : STATE_PLAYING;
+    client->network = net;
+    client->index = net->client_count;
+    net->clients[net->client_count++] = client;
+    return client;
+}
+
+// game_create logs every egg it lays: stdout is muted meanwhile
+game_t *micro_game_create(int width, int height, int players)
+{
+    static char *teams[] = {"bench"};
+    int null_fd = open("/dev/null", O_WRONLY);
+    int stdout_fd = dup(STDOUT_FILENO);
+
+    fflush(stdout);
+    dup2(null_fd, STDOUT_FILENO);
+    game_t *game = game_create(width, height, teams, 1, players);
+    for (int i = 0; i < players; i++) game_add_player(game, i, "bench");
+    fflush(stdout);
+    dup2(stdout_fd, STDOUT_FILENO);
+    close(stdout_fd);
+    close(null_fd);
+    return game;
+}
+
+server_t *micro_server_create(int width, int height, int players, int guis)
+{
+    static char *teams[] = {"bench"};
+    server_t *server = calloc(1, sizeof(server_t));
+    config_t *config = calloc(1, sizeof(config_t));
+    network_t *net = calloc(1, sizeof(network_t));
+
+    config->width = width;
+    config->height = height;
+    config->clients_nb = players;
+    config->team_names = teams;
+    config->team_count = 1;
+    config->freq = 100;
+    config->output_hwm = OUTPUT_HWM_DEFAULT;
+    net->output_hwm = config->output_hwm;
+    net->output_limit = config->output_hwm * OUTPUT_LIMIT_FACTOR;
+    net->client_capacity = players + guis;
+    net->clients = calloc(net->client_capacity, sizeof(client_t *));
+
+    server->config = config;
+    server->network = net;
+    server->actions = scheduler_create();
+    server->game = micro_game_create(width, height, players);
+    g_server = server;
+
+    for (int i = 0; i < players; i++) {
+        client_t *client = micro_client(net, CLIENT_AI);
+        player_t *player = server->game->players[i];
+        client->player_id = player->id;
+        client->team_id = player->team_id;
+        player->client = client;
+    }
+    for (int i = 0; i < guis; i++) micro_client(net, CLIENT_GUI);
+    micro_drain(server);
+    return server;
+}
+
+void micro_server_destroy(server_t *server)
+{
+    network_t *net = server->network;
+
+    for (int i = 0; i < net->client_count; i++) client_destroy(net->clients[i]);
+    free(net->clients);
+    free(net->dirty);
+    free(net);
+    game_destroy(server->game);
+    scheduler_destroy(server->actions);
+    free(server->config);
+    free(server);
+    g_server = NULL;
+}
+
+void micro_drain(server_t *server)
+{
+    network_t *net = server->network;
+
+    for (int i = 0; i < net->dirty_count; i++) {
+        if (!net->dirty[i]) continue;
+        outbuf_clear(&net->dirty[i]->output);
+        net->dirty[i]->dirty_index = -1;
+    }
+    net->dirty_count = 0;
+}
@@ -0,0 +1,31 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Shared helpers for the in-process microbenchmarks
+*/
+
+#ifndef MICRO_H_
+#define MICRO_H_
+
+#include <stdint.h>
+#include "server.h"
+
+// Monotonic clock in nanoseconds
+uint64_t micro_now_ns(void);
+
+// Keeps a computed value alive so the measured loop is not optimized out
+void micro_sink(uint64_t value);
+
+// Game with one team of players joined players, none with a client
+game_t *micro_game_create(int width, int height, int players);
+
+// Server on a width x height map with one team of players AI clients and
+// guis GUI clients, none of them on a socket. Sets g_server
+server_t *micro_server_create(int width, int height, int players, int guis);
+void micro_server_destroy(server_t *server);
+
+// Drops the output queued since the last call, as a flush would
+void micro_drain(server_t *server);
+
+#endif /* !MICRO_H_ */
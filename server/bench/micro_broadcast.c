@@ -0,0 +1,44 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Broadcast fan-out microbenchmark
+*/
+
+// One player broadcasts to every other player of an in-memory server;
+// queued output is dropped every 16 broadcasts.
+//
+//   bin/micro_broadcast [players] [text bytes] [broadcasts]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "broadcast.h"
+#include "game.h"
+#include "micro.h"
+
+int main(int argc, char **argv)
+{
+    int players = argc > 1 ? atoi(argv[1]) : 1000;
+    int text_size = argc > 2 ? atoi(argv[2]) : 5;
+    int count = argc > 3 ? atoi(argv[3]) : 2000;
+    server_t *server = micro_server_create(50, 50, players, 0);
+    game_t *game = server->game;
+    char *text = malloc(text_size + 1);
+
+    memset(text, 'x', text_size);
+    text[text_size] = '\0';
+
+    uint64_t start = micro_now_ns();
+    for (int i = 0; i < count; i++) {
+        broadcast_send_to_all(game, game->players[i % game->player_count], text);
+        if (i % 16 == 15) micro_drain(server);
+    }
+    uint64_t elapsed = micro_now_ns() - start;
+
+    printf("broadcast_send_to_all: %d players, %d-byte text, %.1f us per broadcast\n",
+           players, text_size, elapsed / 1e3 / count);
+    free(text);
+    micro_server_destroy(server);
+    return 0;
+}
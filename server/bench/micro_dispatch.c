@@ -0,0 +1,46 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** AI command decoding microbenchmark
+*/
+
+// Decodes each of the 12 AI commands in turn, as command_process does
+// for every line, and reports the cost per command.
+//
+//   bin/micro_dispatch [commands]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "command.h"
+#include "micro.h"
+
+static const char *lines[] = {
+    "Forward", "Right", "Left", "Look", "Inventory", "Broadcast hello team",
+    "Connect_nbr", "Fork", "Eject", "Take linemate", "Set food", "Incantation"
+};
+#define LINE_COUNT (int)(sizeof(lines) / sizeof(lines[0]))
+
+int main(int argc, char **argv)
+{
+    long count = argc > 1 ? atol(argv[1]) : 2000000;
+    size_t lengths[LINE_COUNT];
+    command_t command;
+    uint64_t opcodes = 0;
+
+    for (int i = 0; i < LINE_COUNT; i++) lengths[i] = strlen(lines[i]);
+
+    uint64_t start = micro_now_ns();
+    for (long i = 0; i < count; i++) {
+        int line = i % LINE_COUNT;
+        command_decode(lines[line], lengths[line], &command);
+        opcodes += command.opcode + command.resource;
+    }
+    uint64_t elapsed = micro_now_ns() - start;
+
+    micro_sink(opcodes);
+    printf("command_decode: %ld commands, %.1f ns/command\n",
+           count, (double)elapsed / count);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Look microbenchmark, per level
+*/
+
+// Runs Look at each level from 1 to 8 on a crowded in-memory server:
+// every tile holds a few units of each resource besides the players.
+// Queued output is dropped every 16 looks.
+//
+//   bin/micro_look [players] [looks per level]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "command.h"
+#include "game.h"
+#include "map.h"
+#include "player.h"
+#include "micro.h"
+
+#define MAP_SIZE 20
+#define UNITS_PER_TILE 3
+
+int main(int argc, char **argv)
+{
+    int players = argc > 1 ? atoi(argv[1]) : 2000;
+    int count = argc > 2 ? atoi(argv[2]) : 20000;
+    server_t *server = micro_server_create(MAP_SIZE, MAP_SIZE, players, 0);
+    map_t *map = server->game->map;
+
+    for (int y = 0; y < MAP_SIZE; y++) {
+        for (int x = 0; x < MAP_SIZE; x++) {
+            tile_t *tile = map_get_tile(map, x, y);
+            for (int resource = 0; resource < RESOURCE_COUNT; resource++) {
+                map_add_resource(map, tile, resource, UNITS_PER_TILE);
+            }
+        }
+    }
+
+    player_t *player = server->game->players[0];
+    client_t *client = player->client;
+    for (int level = 1; level <= 8; level++) {
+        player->level = level;
+
+        uint64_t start = micro_now_ns();
+        for (int i = 0; i < count; i++) {
+            player->orientation = i % 4 + 1;
+            cmd_look(server, client, player, NULL);
+            if (i % 16 == 15) micro_drain(server);
+        }
+        uint64_t elapsed = micro_now_ns() - start;
+
+        micro_drain(server);
+        printf("cmd_look: level %d, %d players on %dx%d, %.2f us per look\n",
+               level, players, MAP_SIZE, MAP_SIZE, elapsed / 1e3 / count);
+    }
+    micro_server_destroy(server);
+    return 0;
+}
@@ -0,0 +1,65 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Protocol line building microbenchmark
+*/
+
+// Calls the GUI reply and notification builders in a loop against an
+// in-memory server and reports millions of lines per second; queued
+// output is dropped every 64 calls.
+//
+//   bin/micro_reply [calls]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "gui_protocol.h"
+#include "game.h"
+#include "micro.h"
+
+typedef enum {
+    CASE_PPO_REPLY,
+    CASE_PIN_REPLY,
+    CASE_BCT_REPLY,
+    CASE_PIN_NOTIFY,
+    CASE_PPO_NOTIFY
+} case_kind_t;
+
+static void run_case(const char *name, case_kind_t kind, int guis, long calls)
+{
+    server_t *server = micro_server_create(20, 20, 4, guis);
+    network_t *net = server->network;
+    client_t *gui = net->clients[net->client_count - 1];
+    player_t *player = server->game->players[0];
+
+    uint64_t start = micro_now_ns();
+    for (long i = 0; i < calls; i++) {
+        switch (kind) {
+        case CASE_PPO_REPLY: gui_cmd_ppo(server, gui, player->id); break;
+        case CASE_PIN_REPLY: gui_cmd_pin(server, gui, player->id); break;
+        case CASE_BCT_REPLY: gui_cmd_bct(server, gui, i % 20, i / 20 % 20); break;
+        case CASE_PIN_NOTIFY: gui_notify_player_inventory(server, player); break;
+        case CASE_PPO_NOTIFY: gui_notify_player_position(server, player); break;
+        }
+        if (i % 64 == 63) micro_drain(server);
+    }
+    uint64_t elapsed = micro_now_ns() - start;
+
+    // Notifications produce one line per GUI
+    double lines = (double)calls * (kind >= CASE_PIN_NOTIFY ? guis : 1);
+    printf("%-22s %5.1f M lines/s\n", name, lines / elapsed * 1e3);
+    micro_server_destroy(server);
+}
+
+int main(int argc, char **argv)
+{
+    long calls = argc > 1 ? atol(argv[1]) : 2000000;
+
+    run_case("ppo reply", CASE_PPO_REPLY, 1, calls);
+    run_case("pin reply", CASE_PIN_REPLY, 1, calls);
+    run_case("bct reply", CASE_BCT_REPLY, 1, calls);
+    run_case("pin notify, 1 GUI", CASE_PIN_NOTIFY, 1, calls);
+    run_case("pin notify, 16 GUIs", CASE_PIN_NOTIFY, 16, calls / 16);
+    run_case("ppo notify, 16 GUIs", CASE_PPO_NOTIFY, 16, calls / 16);
+    return 0;
+}
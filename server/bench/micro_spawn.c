@@ -0,0 +1,51 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Resource respawn microbenchmark
+*/
+
+// Times game_spawn_resources on a full map ("steady", what every 20th
+// tick pays) and on a map emptied before each call ("depleted").
+//
+//   bin/micro_spawn [side] [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "game.h"
+#include "micro.h"
+
+static void map_empty(map_t *map)
+{
+    for (int i = 0; i < map->width * map->height; i++) {
+        for (int res = 0; res < RESOURCE_COUNT; res++) {
+            map_remove_resource(map, &map->tiles[i], res, map->tiles[i].resources[res]);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int side = argc > 1 ? atoi(argv[1]) : 100;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+    server_t *server = micro_server_create(side, side, 1, 0);
+    game_t *game = server->game;
+    uint64_t steady = 0;
+    uint64_t depleted = 0;
+
+    for (int i = 0; i < rounds; i++) {
+        uint64_t start = micro_now_ns();
+        game_spawn_resources(game);
+        steady += micro_now_ns() - start;
+
+        map_empty(game->map);
+        start = micro_now_ns();
+        game_spawn_resources(game);
+        depleted += micro_now_ns() - start;
+    }
+
+    printf("game_spawn_resources: %dx%d, steady %.3f ms, depleted %.3f ms\n",
+           side, side, steady / 1e6 / rounds, depleted / 1e6 / rounds);
+    micro_server_destroy(server);
+    return 0;
+}
@@ -0,0 +1,34 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Game tick microbenchmark
+*/
+
+// Times game_tick while nobody starves: the players joined with 10
+// food, which lasts 1260 ticks.
+//
+//   bin/micro_tick [players] [ticks]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "game.h"
+#include "micro.h"
+
+int main(int argc, char **argv)
+{
+    int players = argc > 1 ? atoi(argv[1]) : 10000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 1000;
+    game_t *game = micro_game_create(100, 100, players);
+
+    if (ticks >= 10 * LIFE_UNITS_PER_FOOD) ticks = 10 * LIFE_UNITS_PER_FOOD - 1;
+
+    uint64_t start = micro_now_ns();
+    for (int i = 0; i < ticks; i++) game_tick(game);
+    uint64_t elapsed = micro_now_ns() - start;
+
+    printf("game_tick: %d players, %.1f us per tick\n",
+           game->player_count, elapsed / 1e3 / ticks);
+    game_destroy(game);
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Connection storm: time from connect to WELCOME
+*/
+
+// Starts every connect at once without waiting, then reports how many
+// connections got WELCOME and the time each took, as percentiles.
+//
+//   bench_storm -p port [-c connections] [-t timeout seconds]
+//
+// Raise the open file limit (ulimit -n) above the connection count,
+// for this client and for the server.
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <getopt.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    uint16_t port = 0;
+    int count = 600;
+    double timeout = 20.0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:c:t:")) != -1) {
+        switch (opt) {
+        case 'p': port = atoi(optarg); break;
+        case 'c': count = atoi(optarg); break;
+        case 't': timeout = atof(optarg); break;
+        default: port = 0; optind = argc; break;
+        }
+    }
+    if (!port || count < 1) {
+        fprintf(stderr, "USAGE: %s -p port [-c connections] [-t timeout]\n", argv[0]);
+        return 84;
+    }
+
+    struct pollfd *fds = calloc(count, sizeof(struct pollfd));
+    uint64_t *started = calloc(count, sizeof(uint64_t));
+    uint64_t *welcome = calloc(count, sizeof(uint64_t));
+    if (!fds || !started || !welcome) return 84;
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (int i = 0; i < count; i++) {
+        fds[i].fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (fds[i].fd < 0) {
+            perror("socket");
+            return 84;
+        }
+        fds[i].events = POLLIN;
+        started[i] = now_us();
+        connect(fds[i].fd, (struct sockaddr *)&addr, sizeof(addr));
+    }
+
+    // A connection is done once it answered, was closed or failed
+    uint64_t deadline = now_us() + (uint64_t)(timeout * 1e6);
+    int done = 0;
+    int welcomed = 0;
+    while (done < count && now_us() < deadline) {
+        if (poll(fds, count, 100) <= 0) continue;
+        for (int i = 0; i < count; i++) {
+            if (fds[i].fd < 0 || !fds[i].revents) continue;
+            char line[16];
+            ssize_t received = recv(fds[i].fd, line, sizeof(line), 0);
+            if (received >= 8 && memcmp(line, "WELCOME\n", 8) == 0) {
+                welcome[welcomed++] = now_us() - started[i];
+            }
+            close(fds[i].fd);
+            fds[i].fd = -1;
+            done++;
+        }
+    }
+
+    printf("%d/%d welcomed", welcomed, count);
+    if (welcomed > 0) {
+        qsort(welcome, welcomed, sizeof(uint64_t), compare_u64);
+        printf(", time to WELCOME p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms",
+               welcome[welcomed / 2] / 1e3, welcome[welcomed * 9 / 10] / 1e3,
+               welcome[welcomed * 99 / 100] / 1e3, welcome[welcomed - 1] / 1e3);
+    }
+    printf("\n");
+    return 0;
+}
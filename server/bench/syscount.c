@@ -0,0 +1,160 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** LD_PRELOAD shim counting the server's network syscalls
+*/
+
+// Counts the socket, wait and io_uring calls made through libc and
+// prints the totals to stderr at exit:
+//
+//   LD_PRELOAD=bin/syscount.so bin/zappy_server ...
+//
+// Calls libc makes internally (eventfd_read/eventfd_write) bypass the
+// shim and are not counted.
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+typedef enum {
+    COUNT_RECV,
+    COUNT_SEND,
+    COUNT_WAIT,
+    COUNT_CTL,
+    COUNT_ACCEPT,
+    COUNT_URING,
+    COUNT_KINDS
+} count_kind_t;
+
+static const char *names[COUNT_KINDS] = {
+    "recv", "send", "wait", "ctl", "accept", "io_uring_enter"
+};
+static atomic_ullong counts[COUNT_KINDS];
+
+#define REAL(name) \
+    static __typeof__(name) *real_##name; \
+    if (!real_##name) real_##name = dlsym(RTLD_NEXT, #name)
+
+#define COUNT(kind) atomic_fetch_add_explicit(&counts[kind], 1, memory_order_relaxed)
+
+ssize_t read(int fd, void *buf, size_t len)
+{
+    REAL(read);
+    COUNT(COUNT_RECV);
+    return real_read(fd, buf, len);
+}
+
+ssize_t recv(int fd, void *buf, size_t len, int flags)
+{
+    REAL(recv);
+    COUNT(COUNT_RECV);
+    return real_recv(fd, buf, len, flags);
+}
+
+ssize_t recvmsg(int fd, struct msghdr *msg, int flags)
+{
+    REAL(recvmsg);
+    COUNT(COUNT_RECV);
+    return real_recvmsg(fd, msg, flags);
+}
+
+ssize_t write(int fd, const void *buf, size_t len)
+{
+    REAL(write);
+    // stdout and stderr are the server's logs, not its traffic
+    if (fd > STDERR_FILENO) COUNT(COUNT_SEND);
+    return real_write(fd, buf, len);
+}
+
+ssize_t writev(int fd, const struct iovec *iov, int count)
+{
+    REAL(writev);
+    COUNT(COUNT_SEND);
+    return real_writev(fd, iov, count);
+}
+
+ssize_t send(int fd, const void *buf, size_t len, int flags)
+{
+    REAL(send);
+    COUNT(COUNT_SEND);
+    return real_send(fd, buf, len, flags);
+}
+
+ssize_t sendmsg(int fd, const struct msghdr *msg, int flags)
+{
+    REAL(sendmsg);
+    COUNT(COUNT_SEND);
+    return real_sendmsg(fd, msg, flags);
+}
+
+int poll(struct pollfd *fds, nfds_t count, int timeout)
+{
+    REAL(poll);
+    COUNT(COUNT_WAIT);
+    return real_poll(fds, count, timeout);
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int max, int timeout)
+{
+    REAL(epoll_wait);
+    COUNT(COUNT_WAIT);
+    return real_epoll_wait(epfd, events, max, timeout);
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+    REAL(epoll_ctl);
+    COUNT(COUNT_CTL);
+    return real_epoll_ctl(epfd, op, fd, event);
+}
+
+int accept(int fd, struct sockaddr *addr, socklen_t *len)
+{
+    REAL(accept);
+    COUNT(COUNT_ACCEPT);
+    return real_accept(fd, addr, len);
+}
+
+int accept4(int fd, struct sockaddr *addr, socklen_t *len, int flags)
+{
+    REAL(accept4);
+    COUNT(COUNT_ACCEPT);
+    return real_accept4(fd, addr, len, flags);
+}
+
+// io_uring has no libc wrapper: the server goes through syscall()
+long syscall(long number, ...)
+{
+    REAL(syscall);
+    va_list ap;
+    long args[6];
+
+    va_start(ap, number);
+    for (int i = 0; i < 6; i++) args[i] = va_arg(ap, long);
+    va_end(ap);
+    if (number == SYS_io_uring_enter) COUNT(COUNT_URING);
+    return real_syscall(number, args[0], args[1], args[2], args[3], args[4], args[5]);
+}
+
+__attribute__((destructor))
+static void syscount_report(void)
+{
+    unsigned long long total = 0;
+
+    fprintf(stderr, "syscount:");
+    for (int i = 0; i < COUNT_KINDS; i++) {
+        unsigned long long count = atomic_load(&counts[i]);
+        fprintf(stderr, " %s %llu,", names[i], count);
+        total += count;
+    }
+    fprintf(stderr, " total %llu\n", total);
+}
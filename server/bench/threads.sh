@@ -0,0 +1,40 @@
+#!/bin/sh
+##
+## EPITECH PROJECT, 2025
+## zappy_server
+## File description:
+## Tick jitter and throughput with and without I/O threads
+##
+
+# For -t 0, 2 and 4, loads the server with bench_load bots and GUIs
+# while one probe bot sends Forward, a 7-tick action, one at a time.
+# Prints the load's throughput and the probe's round trips: anything
+# beyond 7 ticks (70 ms at the default -f 100) is tick lateness.
+#
+#   bench/threads.sh [bots] [guis] [seconds] [freq]
+#
+# Run from server/ after make bench.
+
+BOTS=${1:-1000}
+GUIS=${2:-4}
+SECONDS_RUN=${3:-10}
+FREQ=${4:-100}
+PORT=${PORT:-4345}
+LOAD=$(mktemp)
+
+for threads in 0 2 4; do
+    ./bin/zappy_server -p "$PORT" -x 50 -y 50 -n bench -c $((BOTS + 1)) \
+        -f "$FREQ" -t "$threads" >/dev/null 2>&1 &
+    server=$!
+    sleep 0.5
+    ./bin/bench_load -p "$PORT" -n bench -b "$BOTS" -g "$GUIS" -d "$SECONDS_RUN" \
+        >"$LOAD" &
+    load=$!
+    probe=$(./bin/bench_load -p "$PORT" -n bench -b 1 -d "$SECONDS_RUN" -m Forward -r)
+    wait "$load"
+    kill -INT "$server"
+    wait "$server"
+    echo "-t $threads: $(cat "$LOAD")"
+    echo "-t $threads: Forward $(echo "$probe" | sed -n 's/^round trip: //p')"
+done
+rm -f "$LOAD"
@@ -0,0 +1,42 @@
+#!/bin/sh
+##
+## EPITECH PROJECT, 2025
+## zappy_server
+## File description:
+## Round trips over TCP and over the Unix socket
+##
+
+# For each backend, starts one server listening on both the port and a
+# Unix socket. Runs bots sending Connect_nbr, an immediate command, one
+# at a time over TCP and then over the socket. Prints the round trips
+# and the reply rate for both transports.
+#
+#   bench/transports.sh [bots] [seconds]
+#
+# Run from server/ after make bench.
+
+BOTS=${1:-1}
+SECONDS_RUN=${2:-3}
+PORT=${PORT:-4346}
+SOCKET=$(mktemp -u)
+
+for backend in poll epoll uring; do
+    ./bin/zappy_server -p "$PORT" -u "$SOCKET" -x 20 -y 20 -n bench \
+        -c $((BOTS * 2)) -f 10 -e "$backend" >/dev/null 2>&1 &
+    server=$!
+    sleep 0.5
+    for transport in tcp unix; do
+        if [ "$transport" = tcp ]; then
+            target="-p $PORT"
+        else
+            target="-u $SOCKET"
+        fi
+        result=$(./bin/bench_load $target -n bench -b "$BOTS" -d "$SECONDS_RUN" \
+            -m Connect_nbr -r)
+        rate=$(echo "$result" | sed -n 's/.*replies (\([0-9]*\)\/s).*/\1/p')
+        echo "$backend, $transport, $BOTS bots: $rate replies/s," \
+            "$(echo "$result" | sed -n 's/^round trip: //p')"
+    done
+    kill -INT "$server"
+    wait "$server"
+done
@@ -11,6 +11,10 @@
 #include "player.h"
 #include "game.h"
 
+// "message K," prefix of a received broadcast, K at BROADCAST_DIGIT
+#define BROADCAST_PREFIX_SIZE 10
+#define BROADCAST_DIGIT 8
+
 // Broadcast functions
 int broadcast_get_direction(player_t *sender, player_t *receiver, int map_width, int map_height);
 int broadcast_get_direction_from_orientation(orientation_t orientation);
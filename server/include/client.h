@@ -9,34 +9,55 @@
 #define CLIENT_H_
 
 #include <stdbool.h>
-#include <time.h>
-#include <sys/time.h>
+#include <stdint.h>
 #include "server.h"
+#include "inbuf.h"
+#include "outbuf.h"
+#include "msg.h"
+
+// Decoded command: opcode (opcode_t) plus its argument
+typedef struct command_s {
+    uint8_t opcode;
+    int8_t resource;    // Take/Set object, -1 if not a resource
+    uint16_t offset;    // Broadcast text within the line
+    uint16_t length;
+} command_t;
 
 // Client structure
 struct client_s {
     int fd;
     client_type_t type;
     client_state_t state;
+
+    // Owning network and position in network->clients
+    network_t *network;
+    int index;
+    uint32_t events;  // EVENT_* interest currently registered
+    bool paused;      // input paused until output drains (backpressure)
+    bool closing;     // queued for disconnection by network_reap_clients
+    client_t *closing_next;  // next in network->closing
+    int dirty_index;  // position in network->dirty, -1 if nothing to flush
+    io_conn_t *conn;  // socket owned by an I/O thread, NULL without them
+    uring_conn_t *uring_conn;  // io_uring requests, NULL with other backends
+    shm_conn_t *shm;  // shared-memory rings, NULL while lines use the socket
     
     // Network buffers
-    char input_buffer[BUFFER_SIZE];
-    size_t input_size;
-    char output_buffer[BUFFER_SIZE];
-    size_t output_size;
+    inbuf_t input;
+    outbuf_t output;
     
-    // Command queue for AI clients
+    // Command queue for AI clients: a ring of decoded commands
     struct {
-        char *commands[MAX_COMMANDS];
+        command_t commands[MAX_COMMANDS];
+        int head;
         int count;
-        int executing;
+        char text[MAX_COMMANDS][MAX_COMMAND_ARG];  // Broadcast text per slot
     } cmd_queue;
     
-    // Current action timing
+    // Current action timing (the action is the head of cmd_queue)
     struct {
-        char *command;
-        struct timeval start_time;
+        uint64_t deadline; // game tick at which the action completes
         int duration; // in time units
+        int sched_index; // position in server->actions, -1 if idle
         bool is_active;
     } current_action;
     
@@ -53,12 +74,21 @@ struct client_s {
 // Client functions
 client_t *client_create(int fd);
 void client_destroy(client_t *client);
-bool client_add_command(client_t *client, const char *command);
-char *client_get_current_command(client_t *client);
+bool client_add_command(client_t *client, const command_t *command, const char *line);
+const command_t *client_get_current_command(client_t *client);
+const char *client_command_text(client_t *client, const command_t *command);
 void client_command_done(client_t *client);
 bool client_can_send_command(client_t *client);
-void client_start_action(client_t *client, const char *command, int duration);
-bool client_action_done(client_t *client, int freq);
-void client_send(client_t *client, const char *format, ...);
+void client_start_action(server_t *server, client_t *client, int duration);
+void client_finish_action(server_t *server, client_t *client);
+void client_write(client_t *client, const char *data, size_t len);
+void client_commit(client_t *client);
+bool client_begin(client_t *client, msg_t *msg, size_t max);
+void client_end(client_t *client, msg_t *msg);
+void client_close(client_t *client);
+
+// Fixed reply, its length known at compile time
+#define client_send_literal(client, text) \
+    client_write((client), (text), sizeof(text) - 1)
 
 #endif /* !CLIENT_H_ */
\ No newline at end of file
@@ -12,23 +12,43 @@
 #include "client.h"
 #include "player.h"
 
+// AI command opcodes, indexes into the dispatch table
+typedef enum {
+    OP_FORWARD = 0,
+    OP_RIGHT,
+    OP_LEFT,
+    OP_LOOK,
+    OP_INVENTORY,
+    OP_BROADCAST,
+    OP_CONNECT_NBR,
+    OP_FORK,
+    OP_EJECT,
+    OP_TAKE,
+    OP_SET,
+    OP_INCANTATION,
+    OP_UNKNOWN,
+    OP_COUNT
+} opcode_t;
+
 // Command processing
-void command_process(server_t *server, client_t *client, const char *command);
-void command_execute(server_t *server, client_t *client, player_t *player, const char *command);
-void process_gui_command(server_t *server, client_t *client, const char *command);
+void command_process(server_t *server, client_t *client, const char *command,
+                     size_t len, const command_t *decoded);
+void command_decode(const char *line, size_t len, command_t *command);
+void command_execute(server_t *server, client_t *client, player_t *player, const command_t *command);
+void process_gui_command(server_t *server, client_t *client, const char *command, size_t len);
 
 // AI Commands
-void cmd_forward(server_t *server, client_t *client, player_t *player);
-void cmd_right(server_t *server, client_t *client, player_t *player);
-void cmd_left(server_t *server, client_t *client, player_t *player);
-void cmd_look(server_t *server, client_t *client, player_t *player);
-void cmd_inventory(server_t *server, client_t *client, player_t *player);
-void cmd_broadcast(server_t *server, client_t *client, player_t *player, const char *message);
-void cmd_connect_nbr(server_t *server, client_t *client, player_t *player);
-void cmd_fork(server_t *server, client_t *client, player_t *player);
-void cmd_eject(server_t *server, client_t *client, player_t *player);
-void cmd_take(server_t *server, client_t *client, player_t *player, const char *object);
-void cmd_set(server_t *server, client_t *client, player_t *player, const char *object);
-void cmd_incantation(server_t *server, client_t *client, player_t *player);
+void cmd_forward(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_right(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_left(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_look(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_inventory(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_broadcast(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_connect_nbr(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_fork(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_eject(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_take(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_set(server_t *server, client_t *client, player_t *player, const command_t *command);
+void cmd_incantation(server_t *server, client_t *client, player_t *player, const command_t *command);
 
 #endif /* !COMMAND_H_ */
\ No newline at end of file
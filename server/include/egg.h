@@ -0,0 +1,38 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Egg pool
+*/
+
+#ifndef EGG_H_
+#define EGG_H_
+
+// Egg structure, a slot of the pool
+typedef struct egg_s {
+    int id;
+    int team_id;
+    int x;
+    int y;
+    int team_index;  // Position in its team's egg_ids
+} egg_t;
+
+// All eggs of a game. Slots are reused once freed, so an egg_t pointer
+// is only valid until the next egg_pool_add
+typedef struct egg_pool_s {
+    egg_t *slots;
+    int capacity;
+    int *free_slots;   // Stack of unused slots
+    int free_count;
+    int *slot_by_id;   // Egg id -> slot + 1, 0 once the egg is gone
+    int id_capacity;
+} egg_pool_t;
+
+// Egg pool functions
+egg_pool_t *egg_pool_create(int capacity);
+void egg_pool_destroy(egg_pool_t *pool);
+egg_t *egg_pool_add(egg_pool_t *pool, int id, int team_id, int x, int y);
+egg_t *egg_pool_get(egg_pool_t *pool, int id);
+void egg_pool_remove(egg_pool_t *pool, int id);
+
+#endif /* !EGG_H_ */
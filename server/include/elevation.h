@@ -13,16 +13,32 @@
 #include "player.h"
 #include "map.h"
 
+#define INCANTATION_MAX_PLAYERS 6
+
 // Elevation requirements
 typedef struct elevation_req_s {
     int players;
     int resources[6];  // linemate to thystame
 } elevation_req_t;
 
+// Incantation in progress on a tile, completed by game_tick
+typedef struct incantation_s {
+    int x;
+    int y;
+    int level;      // Level the participants are raised from
+    int initiator;  // Player id
+    int participants[INCANTATION_MAX_PLAYERS];  // Player ids
+    int count;
+    int sched_index;  // Position in game->incantations
+    struct incantation_s *next;  // Free list link
+} incantation_t;
+
 // Elevation functions
 bool elevation_check_requirements(game_t *game, player_t *player, tile_t *tile);
-void elevation_start(game_t *game, player_t *initiator, int x, int y);
-void elevation_complete(game_t *game, player_t *player);
+incantation_t *elevation_start(game_t *game, player_t *initiator);
+void elevation_complete(game_t *game, incantation_t *session);
+void elevation_cancel(game_t *game, incantation_t *session, player_t *leaving);
+void elevation_destroy_all(game_t *game);
 const elevation_req_t *elevation_get_requirements(int level);
 
 #endif /* !ELEVATION_H_ */
\ No newline at end of file
@@ -0,0 +1,23 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Event loop backends
+*/
+
+#ifndef EVENT_H_
+#define EVENT_H_
+
+#include "server.h"
+
+// Event functions
+int event_init(network_t *net, event_backend_t backend);
+void event_destroy(network_t *net);
+int event_add_client(network_t *net, client_t *client);
+void event_update_client(network_t *net, client_t *client);
+void event_remove_client(network_t *net, client_t *client);
+int event_wait(network_t *net, int timeout);
+const char *event_backend_name(event_backend_t backend);
+int event_backend_from_name(const char *name);
+
+#endif /* !EVENT_H_ */
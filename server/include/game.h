@@ -9,21 +9,40 @@
 #define GAME_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "map.h"
 #include "team.h"
 #include "player.h"
+#include "scheduler.h"
+
+#define LIFE_UNITS_PER_FOOD 126
+#define VICTORY_PLAYERS 6  // Players at MAX_LEVEL a team needs to win
 
 // Forward declarations
 typedef struct game_s game_t;
+typedef struct incantation_s incantation_t;
 
 // Game structure
 typedef struct game_s {
     map_t *map;
     team_t **teams;
     int team_count;
+    int *team_table;  // Name hash, open addressing: team id + 1, 0 = empty
+    int team_table_size;
     player_t **players;
     int player_count;
     int player_capacity;
+    // Food state, parallel to players (slot = player->index)
+    int *food;                // Food carried as of meal_tick
+    uint64_t *meal_tick;      // Tick at which life next runs out
+    scheduler_t *starvation;  // Players keyed by the tick they starve at
+    uint64_t tick;            // Ticks run so far
+    scheduler_t *incantations;  // Sessions keyed by completion tick
+    incantation_t *incantation_free;  // Recycled sessions
+    player_t **players_by_id;  // Indexed by player id, NULL once removed
+    int players_by_id_capacity;
+    
+    egg_pool_t *eggs;
     
     // Game state
     int next_player_id;
@@ -40,10 +59,14 @@ game_t *game_create(int width, int height, char **team_names, int team_count, in
 void game_destroy(game_t *game);
 player_t *game_add_player(game_t *game, int client_id, const char *team_name);
 void game_remove_player(game_t *game, int player_id);
+egg_t *game_add_egg(game_t *game, int team_id, int x, int y);
+void game_remove_egg(game_t *game, int egg_id);
 team_t *game_get_team_by_name(game_t *game, const char *name);
 player_t *game_get_player_by_id(game_t *game, int player_id);
-player_t *game_get_player_by_client_id(game_t *game, int client_id);
-void game_tick(game_t *game, int freq);
+int game_player_resource(game_t *game, player_t *player, int resource);
+void game_player_add_resource(game_t *game, player_t *player, int resource, int amount);
+void game_set_player_level(game_t *game, player_t *player, int level);
+void game_tick(game_t *game);
 bool game_check_victory(game_t *game);
 void game_spawn_resources(game_t *game);
 
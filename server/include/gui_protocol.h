@@ -24,6 +24,7 @@ void gui_cmd_plv(server_t *server, client_t *client, int n);
 void gui_cmd_pin(server_t *server, client_t *client, int n);
 void gui_cmd_sgt(server_t *server, client_t *client);
 void gui_cmd_sst(server_t *server, client_t *client, int time);
+void gui_cmd_tlv(server_t *server, client_t *client);
 
 // GUI notifications
 void gui_notify_player_connect(server_t *server, player_t *player);
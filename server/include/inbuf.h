@@ -0,0 +1,28 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Line-framed input buffer
+*/
+
+#ifndef INBUF_H_
+#define INBUF_H_
+
+#include <stddef.h>
+
+#define INBUF_SIZE 4096
+
+// Socket input: unparsed bytes are data[start..size)
+typedef struct inbuf_s {
+    char data[INBUF_SIZE];
+    size_t start;
+    size_t scan;  // bytes before this are known to hold no newline
+    size_t size;
+} inbuf_t;
+
+// Input buffer functions
+int inbuf_fill(inbuf_t *in, int fd);
+size_t inbuf_append(inbuf_t *in, const char *data, size_t len);
+char *inbuf_next_line(inbuf_t *in, size_t *len);
+
+#endif /* !INBUF_H_ */
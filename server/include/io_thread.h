@@ -0,0 +1,97 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Network I/O threads
+*/
+
+#ifndef IO_THREAD_H_
+#define IO_THREAD_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "client.h"
+#include "inbuf.h"
+#include "spsc.h"
+
+#define IO_THREADS_MAX 64
+#define IO_INPUT_RING (16 * 1024)
+#define IO_OUTPUT_RING (64 * 1024)
+
+// Line record in io_conn_t.input, followed by length bytes of text
+typedef struct io_line_s {
+    command_t command;  // Decoded on the I/O thread
+    uint16_t length;
+} io_line_t;
+
+// Room kept free in the input ring before taking another line
+#define IO_LINE_MAX (sizeof(io_line_t) + INBUF_SIZE)
+
+typedef struct io_thread_s io_thread_t;
+
+// Socket owned by an I/O thread. The simulation only reaches it
+// through the two rings and the atomic flags
+struct io_conn_s {
+    int fd;
+    io_thread_t *thread;
+    spsc_ring_t input;        // Decoded lines, I/O thread -> simulation
+    spsc_ring_t output;       // Protocol bytes, simulation -> I/O thread
+    atomic_bool closed;       // EOF or socket error
+    atomic_bool input_full;   // reading stopped until input is drained
+    atomic_bool output_full;  // the simulation waits for room in output
+
+    // I/O thread only
+    inbuf_t buffer;
+    int slot;                 // position in thread->conns
+    uint32_t events;          // EPOLL* interest registered
+    bool watched;             // registered with the thread's epoll
+    bool reading;
+    struct io_conn_s *next;   // added and removed lists
+};
+
+struct io_thread_s {
+    pthread_t thread;
+    io_pool_t *pool;
+    int epoll_fd;
+    int wake_fd;              // eventfd written by the simulation
+    bool signaled;            // simulation only: wake at the end of the iteration
+
+    // Handoffs from the simulation
+    pthread_mutex_t lock;
+    io_conn_t *added;
+    io_conn_t *removed;
+
+    // I/O thread only
+    io_conn_t **conns;
+    int conn_count;
+    int conn_capacity;
+    uint64_t syscalls;
+};
+
+struct io_pool_s {
+    io_thread_t *threads;
+    int count;
+    int started;
+    int next;                 // round robin for new connections
+    int wake_fd;              // eventfd written by the I/O threads
+    atomic_bool running;
+};
+
+// Pool functions, called from the simulation thread
+io_pool_t *io_pool_create(int count);
+void io_pool_stop(io_pool_t *pool);
+void io_pool_destroy(io_pool_t *pool);
+int io_pool_wait(io_pool_t *pool, const int *listen_fds, int listen_count, int timeout);
+void io_pool_wake(io_pool_t *pool);
+uint64_t io_pool_syscalls(io_pool_t *pool);
+
+// Connection functions, called from the simulation thread
+io_conn_t *io_pool_attach(io_pool_t *pool, int fd);
+void io_conn_release(io_conn_t *conn);
+bool io_conn_closed(io_conn_t *conn);
+bool io_conn_next_line(io_conn_t *conn, io_line_t *header, char *text);
+size_t io_conn_send(io_conn_t *conn, const char *data, size_t len);
+
+#endif /* !IO_THREAD_H_ */
@@ -8,28 +8,64 @@
 #ifndef MAP_H_
 #define MAP_H_
 
+#include <stddef.h>
+#include <stdint.h>
 #include "resources.h"
 
+#define TILE_INLINE_IDS 2
+#define TILE_RESOURCE_MAX UINT16_MAX
+#define TILE_BCT_MAX 48
+
+// tile_text_t.valid flags
+#define TILE_TEXT_LOOK 0x1
+#define TILE_TEXT_BCT 0x2
+
 // Forward declarations
 typedef struct tile_s tile_t;
 typedef struct map_s map_t;
 
+// Ids on a tile: stored inline, or in a pooled overflow array once
+// more than TILE_INLINE_IDS are present (capacity is then non-zero)
+typedef struct tile_ids_s {
+    uint32_t count;
+    uint32_t capacity;
+    union {
+        int inline_ids[TILE_INLINE_IDS];
+        int *ids;
+    };
+} tile_ids_t;
+
+// Cached protocol text for a tile, rebuilt lazily once invalidated
+typedef struct tile_text_s {
+    uint8_t valid;            // TILE_TEXT_* parts that are up to date
+    uint8_t bct_size;
+    char bct[TILE_BCT_MAX];   // Resource counts ending a bct line
+    uint32_t look_size;
+    uint32_t look_capacity;
+    char look[];              // Look words, each after a space
+} tile_text_t;
+
 // Tile structure
 typedef struct tile_s {
-    int resources[RESOURCE_COUNT];
-    int *players;      // Array of player IDs
-    int player_count;
-    int *eggs;         // Array of egg IDs
-    int egg_count;
+    uint16_t resources[RESOURCE_COUNT];
+    tile_ids_t players;  // Player IDs
+    tile_ids_t eggs;     // Egg IDs
+    tile_text_t *text;   // NULL until first described
 } tile_t;
 
-// Map structure
+// Map structure: tiles[y * width + x]
 typedef struct map_s {
     int width;
     int height;
-    tile_t **tiles;
+    tile_t *tiles;
+    int64_t totals[RESOURCE_COUNT];  // Units of each resource on the ground
 } map_t;
 
+static inline int *tile_ids(tile_ids_t *list)
+{
+    return list->capacity ? list->ids : list->inline_ids;
+}
+
 // Map functions
 map_t *map_create(int width, int height);
 void map_destroy(map_t *map);
@@ -38,7 +74,12 @@ void map_add_player(map_t *map, int x, int y, int player_id);
 void map_remove_player(map_t *map, int x, int y, int player_id);
 void map_add_egg(map_t *map, int x, int y, int egg_id);
 void map_remove_egg(map_t *map, int x, int y, int egg_id);
+void map_add_resource(map_t *map, tile_t *tile, int resource, int amount);
+void map_remove_resource(map_t *map, tile_t *tile, int resource, int amount);
+const char *tile_look_text(tile_t *tile, size_t *len);
+const char *tile_bct_text(tile_t *tile, size_t *len);
+size_t tile_format_bct(tile_t *tile, char *buffer);
 int map_wrap_x(map_t *map, int x);
 int map_wrap_y(map_t *map, int y);
 
-#endif /* !MAP_H_ */
\ No newline at end of file
+#endif /* !MAP_H_ */
@@ -0,0 +1,80 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Protocol line builder
+*/
+
+#ifndef MSG_H_
+#define MSG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Longest int in decimal, "-2147483648"
+#define MSG_INT_SIZE 11
+
+// Protocol line under construction. The caller sizes the buffer for
+// the line; an append that does not fit is dropped and the whole line
+// marked truncated, so a cut line is never sent
+typedef struct msg_s {
+    char *data;
+    size_t len;
+    size_t capacity;
+    bool truncated;
+    bool heap;  // data allocated by client_begin
+} msg_t;
+
+// Decimal text of value at dst, returns the end. dst needs room for
+// MSG_INT_SIZE bytes
+char *msg_format_uint(char *dst, uint32_t value);
+char *msg_format_int(char *dst, int value);
+
+static inline void msg_init(msg_t *msg, char *buffer, size_t capacity)
+{
+    msg->data = buffer;
+    msg->len = 0;
+    msg->capacity = capacity;
+    msg->truncated = false;
+    msg->heap = false;
+}
+
+static inline void msg_append(msg_t *msg, const char *data, size_t len)
+{
+    if (len > msg->capacity - msg->len) {
+        msg->truncated = true;
+        return;
+    }
+    memcpy(msg->data + msg->len, data, len);
+    msg->len += len;
+}
+
+// Appends a string literal, its length known at compile time
+#define msg_literal(msg, text) msg_append((msg), (text), sizeof(text) - 1)
+
+static inline void msg_str(msg_t *msg, const char *str)
+{
+    msg_append(msg, str, strlen(str));
+}
+
+static inline void msg_char(msg_t *msg, char c)
+{
+    if (msg->len == msg->capacity) {
+        msg->truncated = true;
+        return;
+    }
+    msg->data[msg->len++] = c;
+}
+
+static inline void msg_int(msg_t *msg, int value)
+{
+    if (msg->capacity - msg->len < MSG_INT_SIZE) {
+        msg->truncated = true;
+        return;
+    }
+    msg->len = msg_format_int(msg->data + msg->len, value) - msg->data;
+}
+
+#endif /* !MSG_H_ */
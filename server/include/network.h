@@ -12,8 +12,15 @@
 #include "client.h"
 
 // Network functions
-void network_process_client_data(server_t *server, client_t *client);
-void network_send_to_all_gui(network_t *network, const char *format, ...);
-char *client_read_line(client_t *client);
+bool network_process_client_data(server_t *server, client_t *client);
+void network_process_lines(server_t *server, client_t *client);
+client_t *network_add_client(server_t *server, int fd);
+void network_shed_client(network_t *network, int listen_fd);
+bool network_flush_client(client_t *client);
+void network_flush_pending(network_t *network);
+void network_process_conns(server_t *server);
+void network_process_shm(server_t *server);
+int network_shm_timeout(server_t *server, int timeout);
+void network_send_to_all_gui(network_t *network, const msg_t *msg);
 
 #endif /* !NETWORK_H_ */
\ No newline at end of file
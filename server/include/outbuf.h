@@ -0,0 +1,43 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Chunked output queue
+*/
+
+#ifndef OUTBUF_H_
+#define OUTBUF_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define OUTBUF_CHUNK_SIZE 4096
+#define OUTBUF_MAX_IOV 64
+
+// Output chunk, sent from start to end
+typedef struct out_chunk_s {
+    struct out_chunk_s *next;
+    size_t start;
+    size_t end;
+    char data[OUTBUF_CHUNK_SIZE];
+} out_chunk_t;
+
+// Output queue
+typedef struct outbuf_s {
+    out_chunk_t *head;
+    out_chunk_t *tail;
+    size_t size;  // pending bytes
+} outbuf_t;
+
+// Output queue functions
+bool outbuf_append(outbuf_t *ob, const char *data, size_t len);
+char *outbuf_reserve(outbuf_t *ob, size_t len);
+void outbuf_commit(outbuf_t *ob, size_t len);
+size_t outbuf_peek(outbuf_t *ob, const char **data);
+void outbuf_consume(outbuf_t *ob, size_t len);
+ssize_t outbuf_flush(outbuf_t *ob, int fd, uint64_t *syscalls);
+void outbuf_clear(outbuf_t *ob);
+
+#endif /* !OUTBUF_H_ */
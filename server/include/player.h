@@ -9,7 +9,6 @@
 #define PLAYER_H_
 
 #include <stdbool.h>
-#include <time.h>
 #include "resources.h"
 
 // Orientations
@@ -20,10 +19,17 @@ typedef enum {
     WEST = 4
 } orientation_t;
 
+// Forward declarations
+typedef struct client_s client_t;
+typedef struct incantation_s incantation_t;
+
 // Player structure
 typedef struct player_s {
     int id;
+    int index;  // Position in game->players
+    int starve_index;  // Position in game->starvation
     int client_id;  // Associated client
+    client_t *client;  // Its connection, for replies
     int team_id;
     
     // Position and orientation
@@ -33,22 +39,12 @@ typedef struct player_s {
     
     // Stats
     int level;
-    int life_units;  // 126 units = 1 food
     
-    // Inventory
+    // Inventory; food and life are kept by the game, see game_t
     int inventory[RESOURCE_COUNT];
     
     // State
-    bool is_incanting;
-    bool is_dead;
-    
-    // Current action
-    struct {
-        char *command;
-        time_t end_time;
-        int duration;  // in time units
-    } action;
-    
+    incantation_t *incantation;  // Session taking part in, NULL if none
 } player_t;
 
 // Player functions
@@ -57,9 +53,5 @@ void player_destroy(player_t *player);
 void player_move_forward(player_t *player, int map_width, int map_height);
 void player_turn_right(player_t *player);
 void player_turn_left(player_t *player);
-void player_consume_life(player_t *player);
-bool player_is_alive(player_t *player);
-void player_set_action(player_t *player, const char *command, int duration);
-bool player_action_done(player_t *player, int freq);
 
 #endif /* !PLAYER_H_ */
\ No newline at end of file
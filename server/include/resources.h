@@ -8,6 +8,8 @@
 #ifndef RESOURCES_H_
 #define RESOURCES_H_
 
+#include <stddef.h>
+
 // Resource types
 typedef enum {
     RES_FOOD = 0,
@@ -28,6 +30,7 @@ extern const char *RESOURCE_NAMES[RESOURCE_COUNT];
 
 // Resource functions
 int resource_from_name(const char *name);
+int resource_from_slice(const char *name, size_t len);
 const char *resource_to_name(resource_t resource);
 
 #endif /* !RESOURCES_H_ */
\ No newline at end of file
@@ -0,0 +1,36 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Deadline scheduler (binary min-heap)
+*/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Heap entry: index points into the owner and tracks the entry position
+typedef struct sched_entry_s {
+    uint64_t deadline;
+    void *data;
+    int *index;
+} sched_entry_t;
+
+// Scheduler structure
+typedef struct scheduler_s {
+    sched_entry_t *heap;
+    int count;
+    int capacity;
+} scheduler_t;
+
+// Scheduler functions
+scheduler_t *scheduler_create(void);
+void scheduler_destroy(scheduler_t *sched);
+bool scheduler_push(scheduler_t *sched, uint64_t deadline, void *data, int *index);
+void scheduler_remove(scheduler_t *sched, int *index);
+void scheduler_update(scheduler_t *sched, int *index, uint64_t deadline);
+void *scheduler_pop_due(scheduler_t *sched, uint64_t now);
+
+#endif /* !SCHEDULER_H_ */
@@ -17,6 +17,14 @@
 #define MAX_CLIENTS 1024
 #define BUFFER_SIZE 4096
 #define MAX_COMMANDS 10
+#define MAX_COMMAND_ARG 1024
+#define EVENT_BATCH 256
+#define LISTEN_MAX 2  // TCP, plus the optional Unix socket
+#define LISTEN_BACKLOG_DEFAULT 1024  // the kernel caps it at somaxconn
+#define CLIENT_SLACK 16  // room for GUIs beyond the team slots
+#define OUTPUT_HWM_DEFAULT (1 << 20)
+#define OUTPUT_LIMIT_FACTOR 64
+#define TICK_CATCHUP_MAX 1000  // ticks run per loop turn at most
 
 // Forward declarations
 typedef struct server_s server_t;
@@ -24,6 +32,13 @@ typedef struct game_s game_t;
 typedef struct network_s network_t;
 typedef struct client_s client_t;
 typedef struct player_s player_t;
+typedef struct scheduler_s scheduler_t;
+typedef struct command_s command_t;
+typedef struct io_pool_s io_pool_t;
+typedef struct io_conn_s io_conn_t;
+typedef struct uring_s uring_t;
+typedef struct uring_conn_s uring_conn_t;
+typedef struct shm_conn_s shm_conn_t;
 
 // Action durations in time units
 #define DURATION_FORWARD 7
@@ -37,6 +52,18 @@ typedef struct player_s player_t;
 #define DURATION_FORK 42
 #define DURATION_INCANTATION 300
 
+// Event loop backends
+typedef enum {
+    BACKEND_POLL = 0,
+    BACKEND_EPOLL,
+    BACKEND_URING
+} event_backend_t;
+
+// Event flags reported by the backends
+#define EVENT_READ 0x1
+#define EVENT_HUP 0x2
+#define EVENT_WRITE 0x4
+
 // Server configuration
 typedef struct config_s {
     uint16_t port;
@@ -46,6 +73,11 @@ typedef struct config_s {
     int freq;
     char **team_names;
     int team_count;
+    event_backend_t backend;
+    size_t output_hwm;
+    int io_threads;  // 0: sockets are handled by the server thread
+    const char *unix_path;  // Unix socket to listen on too (from argv), NULL: TCP only
+    int listen_backlog;
 } config_t;
 
 // Client types
@@ -62,15 +94,65 @@ typedef enum {
     STATE_PLAYING
 } client_state_t;
 
+// Ready entry filled by event_wait (data is NULL for a listen socket)
+typedef struct event_ready_s {
+    void *data;
+    uint32_t flags;
+    int fd;  // the ready listen socket when data is NULL
+} event_ready_t;
+
+// Output counters
+typedef struct net_stats_s {
+    uint64_t messages;  // protocol lines queued
+    uint64_t syscalls;  // writev calls issued (io_uring_enter with uring)
+    uint64_t shed;  // connections closed at once for lack of descriptors
+} net_stats_t;
+
 // Network structure
 typedef struct network_s {
-    int listen_fd;
+    // Listen sockets: TCP first, then the Unix socket if configured
+    int listen_fds[LISTEN_MAX];
+    int listen_count;
+    const char *unix_path;
+
+    // Held open so that a connection can still be accepted and shed
+    // when the process runs out of descriptors
+    int spare_fd;
+
+    event_backend_t backend;
+    int epoll_fd;
+    event_ready_t ready[EVENT_BATCH];
     struct pollfd *poll_fds;
     int poll_count;
     int poll_capacity;
     client_t **clients;
     int client_count;
     int client_capacity;
+
+    // Output backpressure: input pauses above hwm, disconnect above limit
+    size_t output_hwm;
+    size_t output_limit;
+
+    // Clients waiting to be disconnected at the end of the iteration,
+    // linked through client->closing_next so that queueing cannot fail
+    client_t *closing;
+    client_t *closing_tail;
+
+    // Clients with output queued during the iteration
+    client_t **dirty;
+    int dirty_count;
+    int dirty_capacity;
+
+    net_stats_t stats;
+
+    // Network I/O threads, NULL unless config->io_threads > 0
+    io_pool_t *io;
+
+    // io_uring backend state, NULL with poll and epoll
+    uring_t *uring;
+
+    // Clients on the shared-memory transport
+    int shm_count;
 } network_t;
 
 // Main server structure
@@ -78,10 +160,13 @@ struct server_s {
     config_t *config;
     game_t *game;
     network_t *network;
+    scheduler_t *actions;
     bool running;
-    struct timeval start_time;
-    struct timeval last_tick;
-    double tick_accumulator;
+
+    // Game clock: tick = tick_base + elapsed monotonic time * freq
+    uint64_t tick;
+    uint64_t tick_base;
+    uint64_t clock_origin; // monotonic microseconds at the last rebase
 };
 
 // Server functions
@@ -89,7 +174,9 @@ server_t *server_create(int argc, char **argv);
 void server_destroy(server_t *server);
 int server_run(server_t *server);
 void server_stop(server_t *server);
-void handle_client_command(server_t *server, client_t *client, const char *command);
+void server_set_freq(server_t *server, int freq);
+void handle_client_command(server_t *server, client_t *client, const char *command,
+                           size_t len, const command_t *decoded);
 
 // Global server instance for signal handling
 extern server_t *g_server;
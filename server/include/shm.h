@@ -0,0 +1,81 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Shared-memory transport for local clients
+*/
+
+#ifndef SHM_H_
+#define SHM_H_
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "server.h"
+#include "inbuf.h"
+
+// Handshake, on the Unix socket only: after WELCOME the client sends
+// "SHM\n" as its first line. The server answers "SHM <ring size>\n"
+// with a memfd and an eventfd attached (SCM_RIGHTS), or "ko\n".
+//
+// The memfd holds an shm_header_t, then the to_server and to_client
+// data, ring_size bytes each from data_offset. Lines, team name first,
+// then go through the rings exactly as they would through the socket.
+// Each side only advances its own index: to_server.tail and
+// to_client.head are the client's, the two others the server's.
+//
+// Wake-ups: a side about to sleep sets its waiting flag, then checks
+// the rings once more. A side that changed a ring checks the peer's
+// flag afterwards and wakes it: the server writes the eventfd, the
+// client writes one byte to the socket. The socket carries nothing
+// else after the handshake; the client closes it to leave.
+#define SHM_MAGIC 0x5a505348  // "ZPSH"
+#define SHM_VERSION 1
+#define SHM_RING_SIZE (64 * 1024)
+#define SHM_CACHE_LINE 64
+
+typedef struct shm_ring_s {
+    _Alignas(SHM_CACHE_LINE) _Atomic uint64_t head;
+    _Alignas(SHM_CACHE_LINE) _Atomic uint64_t tail;
+} shm_ring_t;
+
+typedef struct shm_header_s {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ring_size;       // a power of two
+    uint32_t data_offset;
+    _Alignas(SHM_CACHE_LINE) _Atomic uint32_t server_waiting;
+    _Alignas(SHM_CACHE_LINE) _Atomic uint32_t client_waiting;
+    shm_ring_t to_server;
+    shm_ring_t to_client;
+} shm_header_t;
+
+// Server side of an attached client. The indices the server advances
+// are kept here too: the shared copies are only written, never trusted
+struct shm_conn_s {
+    shm_header_t *header;
+    size_t size;
+    char *to_server;
+    char *to_client;
+    uint64_t input_head;
+    uint64_t output_tail;
+    int event_fd;             // written to wake the client
+};
+
+// Handshake
+bool shm_is_request(const char *line, size_t len);
+shm_conn_t *shm_attach(client_t *client);
+void shm_detach(shm_conn_t *shm);
+
+// Rings
+size_t shm_read(shm_conn_t *shm, inbuf_t *in, bool *invalid);
+size_t shm_write(shm_conn_t *shm, const char *data, size_t len);
+bool shm_output_full(shm_conn_t *shm);
+bool shm_wake_client(shm_conn_t *shm);
+
+// Server sleep: shm_sleep returns false if input is already waiting
+bool shm_sleep(shm_conn_t *shm);
+void shm_awake(shm_conn_t *shm);
+
+#endif /* !SHM_H_ */
@@ -0,0 +1,44 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Single-producer single-consumer byte ring
+*/
+
+#ifndef SPSC_H_
+#define SPSC_H_
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/uio.h>
+
+#define SPSC_CACHE_LINE 64
+
+// Lock-free byte ring between two threads. tail is only advanced by
+// the producer and head only by the consumer, each on its own cache
+// line; both grow forever and are masked into data
+typedef struct spsc_ring_s {
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t head;
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t tail;
+    _Alignas(SPSC_CACHE_LINE) char *data;
+    size_t capacity;  // power of two
+} spsc_ring_t;
+
+// Ring functions
+bool spsc_init(spsc_ring_t *ring, size_t capacity);
+void spsc_destroy(spsc_ring_t *ring);
+
+// Producer side
+size_t spsc_free_space(spsc_ring_t *ring);
+size_t spsc_write(spsc_ring_t *ring, const void *data, size_t len);
+bool spsc_push(spsc_ring_t *ring, const void *header, size_t header_len,
+               const void *data, size_t len);
+
+// Consumer side
+size_t spsc_used(spsc_ring_t *ring);
+int spsc_peek(spsc_ring_t *ring, struct iovec iov[2]);
+size_t spsc_read(spsc_ring_t *ring, void *data, size_t len);
+void spsc_consume(spsc_ring_t *ring, size_t len);
+
+#endif /* !SPSC_H_ */
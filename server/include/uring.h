@@ -0,0 +1,99 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** io_uring network backend
+*/
+
+#ifndef URING_H_
+#define URING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include "server.h"
+#include "outbuf.h"
+
+#define URING_ENTRIES 1024
+#define URING_CQ_ENTRIES 8192
+#define URING_BUFFERS 1024        // provided receive buffers, a power of two
+#define URING_BUFFER_SIZE 2048
+#define URING_BUFFER_GROUP 0
+#define URING_STASH_MAX 8         // buffers a paused client holds before its receive is cancelled
+
+// A client socket. Outlives its client until every request on it has
+// completed, then closes the socket
+struct uring_conn_s {
+    int fd;
+    client_t *client;             // NULL once the client is gone
+    int inflight;                 // requests not completed yet
+    bool receiving;               // multishot receive armed
+    bool canceling;               // cancel of the receive in flight
+    bool starved;                 // receive ended for lack of buffers
+    bool sending;                 // sendmsg in flight
+    bool eof;
+    outbuf_t orphan;              // output of a gone client still being sent
+
+    // Received buffers not copied into the client's input yet
+    int stash_head;
+    int stash_tail;
+    int stash_count;
+    size_t stash_offset;          // bytes of the head buffer already copied
+
+    struct msghdr msg;
+    struct iovec iov[OUTBUF_MAX_IOV];
+    struct uring_conn_s *prev;
+    struct uring_conn_s *next;
+};
+
+// Ring shared with the kernel, plus the provided receive buffers
+struct uring_s {
+    int fd;
+    int listen_fds[LISTEN_MAX];
+    int listen_count;
+    bool accepting[LISTEN_MAX];   // accept, or poll once out of descriptors, armed
+
+    // Submission queue
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sq_local_tail;       // prepared entries, published on enter
+    struct io_uring_sqe *sqes;
+
+    // Completion queue
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *ring;
+    size_t ring_size;
+    size_t sqes_size;
+
+    // Provided buffers: buf_next and buf_len chain stashed buffers
+    struct io_uring_buf_ring *buf_ring;
+    size_t buf_ring_size;
+    uint16_t buf_tail;
+    int buf_free;                 // buffers the kernel can fill
+    char *buffers;
+    int buf_next[URING_BUFFERS];
+    uint32_t buf_len[URING_BUFFERS];
+    int starved;                  // connections waiting for buffers
+
+    uring_conn_t *conns;
+    uint64_t enters;              // io_uring_enter calls that submitted
+};
+
+// Backend functions
+uring_t *uring_create(const int *listen_fds, int listen_count);
+void uring_destroy(uring_t *uring);
+int uring_add_client(uring_t *uring, client_t *client);
+void uring_remove_client(uring_t *uring, client_t *client);
+void uring_send(uring_t *uring, client_t *client);
+int uring_dispatch(server_t *server, int timeout);
+
+#endif /* !URING_H_ */
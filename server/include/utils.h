@@ -9,18 +9,23 @@
 #define UTILS_H_
 
 #include <stdarg.h>
+#include <stdint.h>
 
 // String utilities
 char *str_trim(char *str);
 char **str_split(const char *str, char delim);
 void str_array_free(char **array);
 int str_array_len(char **array);
+uint32_t str_hash(const char *str);
 
 // Logging
 void log_info(const char *format, ...);
 void log_error(const char *format, ...);
 void log_debug(const char *format, ...);
 
+// Time
+uint64_t time_now_us(void);
+
 // Error handling
 void die(const char *format, ...);
 
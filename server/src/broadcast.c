@@ -5,13 +5,13 @@
 ** Broadcast implementation
 */
 
-#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "broadcast.h"
 #include "game.h"
 #include "player.h"
 #include "client.h"
-#include "server.h"
 
 int broadcast_get_direction(player_t *sender, player_t *receiver, 
                            int map_width, int map_height)
@@ -33,12 +33,23 @@ int broadcast_get_direction(player_t *sender, player_t *receiver,
         dy = dy > 0 ? dy - map_height : dy + map_height;
     }
     
-    // Calculate angle from receiver to sender
-    double angle = atan2(dy, dx) * 180.0 / M_PI;
-    angle = fmod(angle + 360.0, 360.0);
-    
-    // Convert to octant (0-7)
-    int octant = (int)((angle + 22.5) / 45.0) % 8;
+    // Octant of the angle from receiver to sender, 0 along +x and
+    // counting towards +y. Sectors are split at 22.5 degrees off each
+    // axis: ay < (sqrt(2) - 1) * ax  <=>  (ax + ay)^2 < 2 * ax^2
+    int64_t ax = abs(dx);
+    int64_t ay = abs(dy);
+    int64_t sum = (ax + ay) * (ax + ay);
+    int octant;
+
+    if (sum < 2 * ax * ax) {
+        octant = dx > 0 ? 0 : 4;
+    } else if (sum < 2 * ay * ay) {
+        octant = dy > 0 ? 2 : 6;
+    } else if (dy > 0) {
+        octant = dx > 0 ? 1 : 3;
+    } else {
+        octant = dx > 0 ? 7 : 5;
+    }
     
     // Adjust for receiver orientation
     int orientation_offset = 0;
@@ -65,28 +76,31 @@ int broadcast_get_direction_from_orientation(orientation_t orientation)
     }
 }
 
+// The message is formatted once; only its direction digit differs
+// between receivers
 void broadcast_send_to_all(game_t *game, player_t *sender, const char *message)
 {
-    extern server_t *g_server;  // Access global server
-    
+    char buffer[BROADCAST_PREFIX_SIZE + MAX_COMMAND_ARG + 1];
+    size_t len = strlen(message);
+
+    if (len > MAX_COMMAND_ARG - 1) len = MAX_COMMAND_ARG - 1;
+    memcpy(buffer, "message 0,", BROADCAST_PREFIX_SIZE);
+    memcpy(buffer + BROADCAST_PREFIX_SIZE, message, len);
+    len += BROADCAST_PREFIX_SIZE;
+    buffer[len++] = '\n';
+
     for (int i = 0; i < game->player_count; i++) {
         player_t *receiver = game->players[i];
         
         // Don't send to self
-        if (receiver->id == sender->id) continue;
+        if (receiver->id == sender->id || !receiver->client) continue;
         
         // Calculate direction
         int direction = broadcast_get_direction(sender, receiver, 
                                               game->map->width, 
                                               game->map->height);
         
-        // Find receiver's client
-        for (int j = 0; j < g_server->network->client_count; j++) {
-            if (g_server->network->clients[j]->player_id == receiver->id) {
-                client_send(g_server->network->clients[j], 
-                           "message %d,%s\n", direction, message);
-                break;
-            }
-        }
+        buffer[BROADCAST_DIGIT] = '0' + direction;
+        client_write(receiver->client, buffer, len);
     }
-}
\ No newline at end of file
+}
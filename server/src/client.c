@@ -7,7 +7,6 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <stdarg.h>
 #include <stdio.h>
 #include <sys/socket.h>
 #include <errno.h>
@@ -15,6 +14,12 @@
 #include <ctype.h>
 #include <sys/time.h>
 #include "client.h"
+#include "network.h"
+#include "scheduler.h"
+#include "event.h"
+#include "io_thread.h"
+#include "uring.h"
+#include "shm.h"
 #include "utils.h"
 
 client_t *client_create(int fd)
@@ -28,7 +33,8 @@ client_t *client_create(int fd)
     client->player_id = -1;
     client->team_id = -1;
     client->current_action.is_active = false;
-    client->current_action.command = NULL;
+    client->current_action.sched_index = -1;
+    client->dirty_index = -1;
 
     return client;
 }
@@ -37,58 +43,62 @@ void client_destroy(client_t *client)
 {
     if (!client) return;
 
-    // Free command queue
-    for (int i = 0; i < client->cmd_queue.count; i++) {
-        free(client->cmd_queue.commands[i]);
-    }
-
-    // Free current action
-    if (client->current_action.command) {
-        free(client->current_action.command);
-    }
+    // Drop unsent output
+    outbuf_clear(&client->output);
+    shm_detach(client->shm);
 
     free(client);
 }
 
-bool client_add_command(client_t *client, const char *command)
+bool client_add_command(client_t *client, const command_t *command, const char *line)
 {
     if (client->cmd_queue.count >= MAX_COMMANDS) {
         return false;  // Queue full
     }
 
-    client->cmd_queue.commands[client->cmd_queue.count] = strdup(command);
+    int slot = (client->cmd_queue.head + client->cmd_queue.count) % MAX_COMMANDS;
+    command_t *cmd = &client->cmd_queue.commands[slot];
+    *cmd = *command;
+
+    // Only a text argument (Broadcast) outlives the input line
+    if (cmd->length > 0) {
+        if (cmd->length >= MAX_COMMAND_ARG) {
+            cmd->length = MAX_COMMAND_ARG - 1;
+        }
+        char *text = client->cmd_queue.text[slot];
+        memcpy(text, line + command->offset, cmd->length);
+        text[cmd->length] = '\0';
+    }
+
     client->cmd_queue.count++;
-    
     return true;
 }
 
-char *client_get_current_command(client_t *client)
+const command_t *client_get_current_command(client_t *client)
 {
-    if (client->cmd_queue.executing >= client->cmd_queue.count) {
+    if (client->cmd_queue.count == 0) {
         return NULL;
     }
     
-    return client->cmd_queue.commands[client->cmd_queue.executing];
+    return &client->cmd_queue.commands[client->cmd_queue.head];
 }
 
-void client_command_done(client_t *client)
+const char *client_command_text(client_t *client, const command_t *command)
 {
-    if (client->cmd_queue.executing >= client->cmd_queue.count) {
-        return;
+    if (command->length == 0) {
+        return "";
     }
+    return client->cmd_queue.text[command - client->cmd_queue.commands];
+}
 
-    // Free executed command
-    free(client->cmd_queue.commands[client->cmd_queue.executing]);
-
-    // Shift commands
-    for (int i = client->cmd_queue.executing; i < client->cmd_queue.count - 1; i++) {
-        client->cmd_queue.commands[i] = client->cmd_queue.commands[i + 1];
+void client_command_done(client_t *client)
+{
+    if (client->cmd_queue.count == 0) {
+        return;
     }
 
+    client->cmd_queue.head = (client->cmd_queue.head + 1) % MAX_COMMANDS;
     client->cmd_queue.count--;
-    
-    // Keep executing index at 0 to process next command
-    client->cmd_queue.executing = 0;
 }
 
 bool client_can_send_command(client_t *client)
@@ -96,143 +106,350 @@ bool client_can_send_command(client_t *client)
     return client->cmd_queue.count < MAX_COMMANDS;
 }
 
-void client_start_action(client_t *client, const char *command, int duration)
+void client_start_action(server_t *server, client_t *client, int duration)
 {
-    if (client->current_action.command) {
-        free(client->current_action.command);
-    }
-    
-    client->current_action.command = strdup(command);
     client->current_action.duration = duration;
-    gettimeofday(&client->current_action.start_time, NULL);
+    client->current_action.deadline = server->tick + duration;
     client->current_action.is_active = true;
+
+    // Completion is driven by the action scheduler in server_run
+    scheduler_push(server->actions, client->current_action.deadline, client,
+                   &client->current_action.sched_index);
 }
 
-bool client_action_done(client_t *client, int freq)
+// End the running action on the current tick, for commands that fail
+// before their duration is up
+void client_finish_action(server_t *server, client_t *client)
 {
-    if (!client->current_action.is_active) return false;
-    
-    struct timeval now;
-    gettimeofday(&now, NULL);
-    
-    double elapsed = (now.tv_sec - client->current_action.start_time.tv_sec) +
-                    (now.tv_usec - client->current_action.start_time.tv_usec) / 1000000.0;
-    
-    double required_time = (double)client->current_action.duration / freq;
-    
-    return elapsed >= required_time;
+    client->current_action.deadline = server->tick;
+    scheduler_update(server->actions, &client->current_action.sched_index,
+                     server->tick);
 }
 
-void client_send(client_t *client, const char *format, ...)
+void client_write(client_t *client, const char *data, size_t len)
 {
-    char buffer[BUFFER_SIZE];
-    va_list args;
-    
-    va_start(args, format);
-    int len = vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-
-    if (len <= 0 || len >= BUFFER_SIZE) return;
-
-    // Try to send immediately
-    int sent = send(client->fd, buffer, len, MSG_DONTWAIT);
-    if (sent < len) {
-        // Buffer the rest
-        int remaining = len - (sent > 0 ? sent : 0);
-        if (client->output_size + remaining < BUFFER_SIZE) {
-            memcpy(client->output_buffer + client->output_size, 
-                   buffer + (sent > 0 ? sent : 0), remaining);
-            client->output_size += remaining;
+    if (client->closing) return;
+
+    if (!outbuf_append(&client->output, data, len)) {
+        client_close(client);
+        return;
+    }
+    client_commit(client);
+}
+
+void client_commit(client_t *client)
+{
+    network_t *net = client->network;
+
+    net->stats.messages++;
+
+    // Sent once per loop iteration by network_flush_pending
+    if (client->dirty_index < 0) {
+        if (net->dirty_count >= net->dirty_capacity) {
+            int capacity = net->dirty_capacity ? net->dirty_capacity * 2 : 64;
+            client_t **dirty = realloc(net->dirty, capacity * sizeof(client_t *));
+            if (!dirty) {
+                client_close(client);
+                return;
+            }
+            net->dirty = dirty;
+            net->dirty_capacity = capacity;
         }
+        client->dirty_index = net->dirty_count;
+        net->dirty[net->dirty_count++] = client;
     }
 }
 
-char *client_read_line(client_t *client)
+// Starts a line of at most max bytes, built in place at the tail of
+// the output queue. Nothing else may be written to the client until
+// the matching client_end
+bool client_begin(client_t *client, msg_t *msg, size_t max)
 {
-    // Receive data
-    char temp[BUFFER_SIZE];
-    int received = recv(client->fd, temp, 
-                       BUFFER_SIZE - client->input_size - 1, MSG_DONTWAIT);
+    if (client->closing) return false;
 
-    if (received > 0) {
-        // Add to buffer
-        memcpy(client->input_buffer + client->input_size, temp, received);
-        client->input_size += received;
-        client->input_buffer[client->input_size] = '\0';
-    } else if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
-        // Connection closed or error
-        return NULL;
+    if (max <= OUTBUF_CHUNK_SIZE) {
+        char *dst = outbuf_reserve(&client->output, max);
+        if (!dst) {
+            client_close(client);
+            return false;
+        }
+        msg_init(msg, dst, max);
+        return true;
     }
 
-    // Look for newline
-    char *newline = strchr(client->input_buffer, '\n');
-    if (!newline) return NULL;
+    // Longer than a chunk: built on the heap, then copied across chunks
+    char *data = malloc(max);
+    if (!data) return false;
+    msg_init(msg, data, max);
+    msg->heap = true;
+    return true;
+}
 
-    // Extract line
-    size_t line_len = newline - client->input_buffer;
-    char *line = malloc(line_len + 1);
-    memcpy(line, client->input_buffer, line_len);
-    line[line_len] = '\0';
+void client_end(client_t *client, msg_t *msg)
+{
+    if (msg->heap) {
+        if (!msg->truncated) client_write(client, msg->data, msg->len);
+        free(msg->data);
+        return;
+    }
 
-    // Remove from buffer
-    memmove(client->input_buffer, newline + 1, 
-            client->input_size - line_len - 1);
-    client->input_size -= line_len + 1;
+    // A truncated line leaves its reserved room unused
+    if (msg->truncated) return;
+    outbuf_commit(&client->output, msg->len);
+    client_commit(client);
+}
 
-    // Trim whitespace
-    char *trimmed = line;
-    while (isspace(*trimmed)) trimmed++;
-    
-    if (*trimmed == 0) {
-        free(line);
-        return NULL;
+void client_close(client_t *client)
+{
+    network_t *net = client->network;
+
+    if (client->closing) return;
+    client->closing = true;
+
+    // Disconnected by network_reap_clients once the iteration is over
+    client->closing_next = NULL;
+    if (net->closing_tail) {
+        net->closing_tail->closing_next = client;
+    } else {
+        net->closing = client;
     }
-    
-    char *end = trimmed + strlen(trimmed) - 1;
-    while (end > trimmed && isspace(*end)) end--;
-    end[1] = '\0';
-    
-    if (trimmed != line) {
-        char *result = strdup(trimmed);
-        free(line);
-        return result;
+    net->closing_tail = client;
+}
+
+// Moves queued output into the I/O thread's ring; what does not fit
+// stays queued until the thread makes room
+static void network_flush_conn(client_t *client)
+{
+    const char *data;
+    size_t len;
+
+    while ((len = outbuf_peek(&client->output, &data)) > 0) {
+        size_t written = io_conn_send(client->conn, data, len);
+        outbuf_consume(&client->output, written);
+        if (written < len) break;
     }
+}
 
-    return line;
+// Moves queued output into the client's shared ring, waking it if it
+// sleeps; what does not fit waits for the client to make room
+static void network_flush_shm(client_t *client)
+{
+    const char *data;
+    size_t len;
+    bool written = false;
+
+    while ((len = outbuf_peek(&client->output, &data)) > 0) {
+        size_t count = shm_write(client->shm, data, len);
+        outbuf_consume(&client->output, count);
+        written |= count > 0;
+        if (count < len) break;
+    }
+    if (written && shm_wake_client(client->shm)) client->network->stats.syscalls++;
 }
 
-void network_process_client_data(server_t *server, client_t *client)
+bool network_flush_client(client_t *client)
 {
-    // Send any buffered output
-    if (client->output_size > 0) {
-        int sent = send(client->fd, client->output_buffer, 
-                       client->output_size, MSG_DONTWAIT);
-        if (sent > 0) {
-            memmove(client->output_buffer, client->output_buffer + sent,
-                    client->output_size - sent);
-            client->output_size -= sent;
+    network_t *net = client->network;
+
+    if (client->shm) {
+        network_flush_shm(client);
+    } else if (client->conn) {
+        network_flush_conn(client);
+    } else if (client->uring_conn) {
+        uring_send(net->uring, client);
+    } else if (outbuf_flush(&client->output, client->fd, &net->stats.syscalls) < 0) {
+        return false;
+    }
+
+    // Slow consumer: give up past the hard limit
+    if (client->output.size > net->output_limit) {
+        log_info("Client %d output exceeds %zu bytes, disconnecting",
+                 client->fd, net->output_limit);
+        return false;
+    }
+
+    // Backpressure: stop reading commands until the backlog drains
+    if (client->output.size > net->output_hwm) {
+        client->paused = true;
+    } else if (client->paused && client->output.size <= net->output_hwm / 2) {
+        client->paused = false;
+    }
+
+    // POLLOUT stays armed only while output is pending; shared-memory
+    // output never waits on the socket
+    if (!client->conn && !client->shm) event_update_client(net, client);
+    return true;
+}
+
+void network_flush_pending(network_t *net)
+{
+    // One writev per client that produced output this iteration
+    for (int i = 0; i < net->dirty_count; i++) {
+        client_t *client = net->dirty[i];
+        if (!client) continue;
+
+        client->dirty_index = -1;
+        if (client->closing) continue;
+        if (!network_flush_client(client)) {
+            client_close(client);
         }
     }
+    net->dirty_count = 0;
+}
+
+// A local client switching to shared memory. Anything it sent after
+// the request is dropped: its lines now come through the ring
+static void network_attach_shm(client_t *client)
+{
+    network_t *net = client->network;
 
-    // Read input
+    client->shm = shm_attach(client);
+    if (!client->shm) {
+        client_send_literal(client, "ko\n");
+        return;
+    }
+    client->input.start = 0;
+    client->input.scan = 0;
+    client->input.size = 0;
+    net->shm_count++;
+    log_info("Client %d switched to shared memory", client->fd);
+}
+
+// Complete lines already in the input buffer, until output backs up
+void network_process_lines(server_t *server, client_t *client)
+{
     char *line;
-    while ((line = client_read_line(client)) != NULL) {
-        if (strlen(line) == 0) {
-            free(line);
-            continue;
+    size_t len;
+
+    while (!client->paused && !client->closing &&
+           (line = inbuf_next_line(&client->input, &len)) != NULL) {
+        if (client->state == STATE_CONNECTING && !client->shm && shm_is_request(line, len)) {
+            network_attach_shm(client);
+            return;
         }
+        handle_client_command(server, client, line, len, NULL);
+    }
+}
 
-        handle_client_command(server, client, line);
-        free(line);
+// Socket bytes of a shared-memory client are only wake-ups. Returns
+// false once the client has closed it
+static bool network_drain_doorbell(client_t *client)
+{
+    char buffer[64];
 
-        // Check if client was disconnected
-        bool still_connected = false;
-        for (int i = 0; i < server->network->client_count; i++) {
-            if (server->network->clients[i] == client) {
-                still_connected = true;
-                break;
-            }
+    for (;;) {
+        ssize_t received = recv(client->fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (received == 0) return false;
+        if (received < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+}
+
+bool network_process_client_data(server_t *server, client_t *client)
+{
+    if (client->shm) return network_drain_doorbell(client);
+
+    // Drain the socket: required by the edge-triggered epoll backend
+    for (;;) {
+        network_process_lines(server, client);
+        if (client->shm) return network_drain_doorbell(client);
+
+        // Leave the rest in the socket while output backs up
+        if (client->paused || client->closing) break;
+
+        int received = inbuf_fill(&client->input, client->fd);
+        if (received < 0) break;
+        if (received == 0) return false;
+    }
+    return true;
+}
+
+// Lines an I/O thread decoded for the client. Returns false once its
+// socket is closed
+static bool network_process_conn(server_t *server, client_t *client)
+{
+    char text[INBUF_SIZE + 1];
+    io_line_t header;
+
+    // Read first: every line of a closed socket is already in the ring
+    bool closed = io_conn_closed(client->conn);
+
+    while (!client->paused && !client->closing &&
+           io_conn_next_line(client->conn, &header, text)) {
+        handle_client_command(server, client, text, header.length, &header.command);
+    }
+    return !closed;
+}
+
+// With I/O threads: new lines of every client, then output that did
+// not fit in a ring the last time
+void network_process_conns(server_t *server)
+{
+    network_t *net = server->network;
+
+    for (int i = 0; i < net->client_count; i++) {
+        client_t *client = net->clients[i];
+        if (client->closing) continue;
+
+        if (!network_process_conn(server, client) ||
+            (client->output.size > 0 && !network_flush_client(client))) {
+            client_close(client);
         }
-        if (!still_connected) break;
     }
-}
\ No newline at end of file
+}
+
+// Lines a shared-memory client wrote, as for a socket: until output
+// backs up or the ring is empty. Returns false on a corrupt ring
+static bool network_process_shm_client(server_t *server, client_t *client)
+{
+    bool invalid = false;
+    bool consumed = false;
+
+    for (;;) {
+        network_process_lines(server, client);
+        if (client->paused || client->closing) break;
+        if (shm_read(client->shm, &client->input, &invalid) == 0) break;
+        consumed = true;
+    }
+
+    // Room was made in its ring; replies, if any, wake it when flushed
+    if (consumed && client->dirty_index < 0 && shm_wake_client(client->shm)) {
+        client->network->stats.syscalls++;
+    }
+    return !invalid;
+}
+
+// Shared-memory clients have no readiness event: every iteration takes
+// their input and retries output that did not fit
+void network_process_shm(server_t *server)
+{
+    network_t *net = server->network;
+
+    for (int i = 0; i < net->client_count; i++) {
+        client_t *client = net->clients[i];
+        if (!client->shm || client->closing) continue;
+
+        shm_awake(client->shm);
+        if (!network_process_shm_client(server, client) ||
+            (client->output.size > 0 && !network_flush_client(client))) {
+            client_close(client);
+        }
+    }
+}
+
+// Timeout for the coming wait: shared-memory clients are told that
+// the server sleeps, and it does not if one of them has work already
+int network_shm_timeout(server_t *server, int timeout)
+{
+    network_t *net = server->network;
+
+    for (int i = 0; i < net->client_count && timeout != 0; i++) {
+        client_t *client = net->clients[i];
+        if (!client->shm || client->closing) continue;
+
+        if (!shm_sleep(client->shm) ||
+            (client->output.size > 0 && !shm_output_full(client->shm))) {
+            timeout = 0;
+        }
+    }
+    return timeout;
+}
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <math.h>
 #include "server.h"
 #include "command.h"
@@ -33,24 +34,25 @@ static void handle_client_authentication(server_t *server, client_t *client, con
     // Check for AI team
     team_t *team = game_get_team_by_name(server->game, data);
     if (!team) {
-        client_send(client, "ko\n");
+        client_send_literal(client, "ko\n");
         return;
     }
 
     int slots = team_available_slots(team);
     if (slots <= 0) {
-        client_send(client, "0\n");
+        client_send_literal(client, "0\n");
         return;
     }
 
     // Create player
     player_t *player = game_add_player(server->game, client->fd, data);
     if (!player) {
-        client_send(client, "ko\n");
+        client_send_literal(client, "ko\n");
         return;
     }
 
     // Setup client
+    player->client = client;
     client->type = CLIENT_AI;
     client->state = STATE_PLAYING;
     client->player_id = player->id;
@@ -58,7 +60,16 @@ static void handle_client_authentication(server_t *server, client_t *client, con
     strcpy(client->team_name, data);
 
     // Send connection response according to protocol
-    client_send(client, "%d %d %d\n", slots - 1, server->config->width, server->config->height);
+    msg_t msg;
+    if (client_begin(client, &msg, 3 * (MSG_INT_SIZE + 1))) {
+        msg_int(&msg, slots - 1);
+        msg_char(&msg, ' ');
+        msg_int(&msg, server->config->width);
+        msg_char(&msg, ' ');
+        msg_int(&msg, server->config->height);
+        msg_char(&msg, '\n');
+        client_end(client, &msg);
+    }
 
     // Notify GUI
     gui_notify_player_connect(server, player);
@@ -67,104 +78,143 @@ static void handle_client_authentication(server_t *server, client_t *client, con
              player->id, team->name, player->x, player->y);
 }
 
-void handle_client_command(server_t *server, client_t *client, const char *command)
+// decoded is the command already decoded by an I/O thread, NULL to
+// decode it here
+void handle_client_command(server_t *server, client_t *client, const char *command,
+                           size_t len, const command_t *decoded)
 {
     if (client->state == STATE_CONNECTING) {
         handle_client_authentication(server, client, command);
     } else if (client->state == STATE_PLAYING) {
-        command_process(server, client, command);
+        command_process(server, client, command, len, decoded);
     }
 }
 
-void command_process(server_t *server, client_t *client, const char *command)
+typedef void (*command_handler_t)(server_t *, client_t *, player_t *, const command_t *);
+
+// Dispatch table entry
+typedef struct command_def_s {
+    const char *name;
+    size_t length;
+    int duration;  // time units, 0 for immediate replies
+    command_handler_t handler;
+} command_def_t;
+
+static void cmd_unknown(server_t *server, client_t *client, player_t *player, const command_t *command);
+
+#define COMMAND_DEF(name, duration, handler) { name, sizeof(name) - 1, duration, handler }
+
+static const command_def_t command_table[OP_COUNT] = {
+    [OP_FORWARD] = COMMAND_DEF("Forward", DURATION_FORWARD, cmd_forward),
+    [OP_RIGHT] = COMMAND_DEF("Right", DURATION_TURN, cmd_right),
+    [OP_LEFT] = COMMAND_DEF("Left", DURATION_TURN, cmd_left),
+    [OP_LOOK] = COMMAND_DEF("Look", DURATION_LOOK, cmd_look),
+    [OP_INVENTORY] = COMMAND_DEF("Inventory", DURATION_INVENTORY, cmd_inventory),
+    [OP_BROADCAST] = COMMAND_DEF("Broadcast", DURATION_BROADCAST, cmd_broadcast),
+    [OP_CONNECT_NBR] = COMMAND_DEF("Connect_nbr", 0, cmd_connect_nbr),
+    [OP_FORK] = COMMAND_DEF("Fork", DURATION_FORK, cmd_fork),
+    [OP_EJECT] = COMMAND_DEF("Eject", DURATION_EJECT, cmd_eject),
+    [OP_TAKE] = COMMAND_DEF("Take", DURATION_TAKE, cmd_take),
+    [OP_SET] = COMMAND_DEF("Set", DURATION_SET, cmd_set),
+    [OP_INCANTATION] = COMMAND_DEF("Incantation", DURATION_INCANTATION, cmd_incantation),
+    [OP_UNKNOWN] = COMMAND_DEF("", 0, cmd_unknown),
+};
+
+void command_process(server_t *server, client_t *client, const char *command,
+                     size_t len, const command_t *decoded)
 {
     if (client->type == CLIENT_AI) {
         // Check if player is dead
         player_t *player = game_get_player_by_id(server->game, client->player_id);
-        if (!player || player->is_dead) {
-            client_send(client, "dead\n");
+        if (!player) {
+            client_send_literal(client, "dead\n");
             return;
         }
         
+        // Decode once, the queue keeps the opcode and argument
+        command_t local;
+        if (!decoded) {
+            command_decode(command, len, &local);
+            decoded = &local;
+        }
+
         // Add to command queue if not full
-        if (!client_add_command(client, command)) {
+        if (!client_add_command(client, decoded, command)) {
             // Queue full, ignore command
             return;
         }
         
         // Execute if no current action
         if (!client->current_action.is_active && client->cmd_queue.count == 1) {
-            command_execute(server, client, player, command);
+            command_execute(server, client, player, client_get_current_command(client));
         }
     } else if (client->type == CLIENT_GUI) {
-        process_gui_command(server, client, command);
+        process_gui_command(server, client, command, len);
     }
 }
 
-void command_execute(server_t *server, client_t *client, player_t *player, const char *command)
+void command_decode(const char *line, size_t len, command_t *command)
 {
-    char cmd[256] = {0};
-    char arg[1024] = {0};
-    
-    // Parse command
-    if (sscanf(command, "%255s %1023[^\n]", cmd, arg) < 1) {
-        client_send(client, "ko\n");
-        client_command_done(client);
-        return;
+    const char *end = line + len;
+    const char *word_end = line;
+
+    // Command word, then its argument after any whitespace
+    while (word_end < end && !isspace((unsigned char)*word_end)) word_end++;
+    const char *arg = word_end;
+    while (arg < end && isspace((unsigned char)*arg)) arg++;
+    size_t word_len = word_end - line;
+
+    command->opcode = OP_UNKNOWN;
+    command->resource = -1;
+    command->offset = 0;
+    command->length = 0;
+
+    for (int op = 0; op < OP_UNKNOWN; op++) {
+        const command_def_t *def = &command_table[op];
+        if (def->length == word_len && def->name[0] == line[0] &&
+            memcmp(def->name, line, word_len) == 0) {
+            command->opcode = op;
+            break;
+        }
     }
-    
-    // Execute command with duration
-    if (strcmp(cmd, "Forward") == 0) {
-        client_start_action(client, command, DURATION_FORWARD);
-        cmd_forward(server, client, player);
-    } else if (strcmp(cmd, "Right") == 0) {
-        client_start_action(client, command, DURATION_TURN);
-        cmd_right(server, client, player);
-    } else if (strcmp(cmd, "Left") == 0) {
-        client_start_action(client, command, DURATION_TURN);
-        cmd_left(server, client, player);
-    } else if (strcmp(cmd, "Look") == 0) {
-        client_start_action(client, command, DURATION_LOOK);
-        cmd_look(server, client, player);
-    } else if (strcmp(cmd, "Inventory") == 0) {
-        client_start_action(client, command, DURATION_INVENTORY);
-        cmd_inventory(server, client, player);
-    } else if (strcmp(cmd, "Broadcast") == 0) {
-        client_start_action(client, command, DURATION_BROADCAST);
-        cmd_broadcast(server, client, player, arg);
-    } else if (strcmp(cmd, "Connect_nbr") == 0) {
-        // No duration, immediate response
-        cmd_connect_nbr(server, client, player);
-        client_command_done(client);
-        // Execute next command if any
-        char *next = client_get_current_command(client);
-        if (next) command_execute(server, client, player, next);
-    } else if (strcmp(cmd, "Fork") == 0) {
-        client_start_action(client, command, DURATION_FORK);
-        cmd_fork(server, client, player);
-    } else if (strcmp(cmd, "Eject") == 0) {
-        client_start_action(client, command, DURATION_EJECT);
-        cmd_eject(server, client, player);
-    } else if (strcmp(cmd, "Take") == 0) {
-        client_start_action(client, command, DURATION_TAKE);
-        cmd_take(server, client, player, arg);
-    } else if (strcmp(cmd, "Set") == 0) {
-        client_start_action(client, command, DURATION_SET);
-        cmd_set(server, client, player, arg);
-    } else if (strcmp(cmd, "Incantation") == 0) {
-        client_start_action(client, command, DURATION_INCANTATION);
-        cmd_incantation(server, client, player);
-    } else {
-        client_send(client, "ko\n");
+
+    if (command->opcode == OP_TAKE || command->opcode == OP_SET) {
+        command->resource = resource_from_slice(arg, end - arg);
+    } else if (command->opcode == OP_BROADCAST) {
+        command->offset = arg - line;
+        command->length = end - arg;
+    }
+}
+
+void command_execute(server_t *server, client_t *client, player_t *player, const command_t *command)
+{
+    // Immediate replies complete on the spot, so loop to the next one
+    while (command) {
+        const command_def_t *def = &command_table[command->opcode];
+
+        if (def->duration > 0) {
+            client_start_action(server, client, def->duration);
+            def->handler(server, client, player, command);
+            return;
+        }
+
+        def->handler(server, client, player, command);
         client_command_done(client);
-        // Execute next command if any
-        char *next = client_get_current_command(client);
-        if (next) command_execute(server, client, player, next);
+        command = client_get_current_command(client);
     }
 }
 
-void cmd_forward(server_t *server, client_t *client, player_t *player)
+static void cmd_unknown(server_t *server, client_t *client, player_t *player, const command_t *command)
+{
+    (void)server;
+    (void)player;
+    (void)command;
+    client_send_literal(client, "ko\n");
+}
+
+void cmd_forward(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     // Remove from current tile
     map_remove_player(server->game->map, player->x, player->y, player->id);
     
@@ -175,133 +225,189 @@ void cmd_forward(server_t *server, client_t *client, player_t *player)
     map_add_player(server->game->map, player->x, player->y, player->id);
     
     // Response
-    client_send(client, "ok\n");
+    client_send_literal(client, "ok\n");
     
     // Notify GUI
     gui_notify_player_position(server, player);
 }
 
-void cmd_right(server_t *server, client_t *client, player_t *player)
+void cmd_right(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     player_turn_right(player);
-    client_send(client, "ok\n");
+    client_send_literal(client, "ok\n");
     gui_notify_player_position(server, player);
 }
 
-void cmd_left(server_t *server, client_t *client, player_t *player)
+void cmd_left(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     player_turn_left(player);
-    client_send(client, "ok\n");
+    client_send_literal(client, "ok\n");
     gui_notify_player_position(server, player);
 }
 
-void cmd_look(server_t *server, client_t *client, player_t *player)
+#define LOOK_MAX_LEVEL 8
+#define LOOK_MAX_TILES ((LOOK_MAX_LEVEL + 1) * (LOOK_MAX_LEVEL + 1))
+
+// Tile offset from the player in a vision cone
+typedef struct look_offset_s {
+    int8_t dx;
+    int8_t dy;
+} look_offset_t;
+
+// Vision cone offsets per orientation, nearest row first; the cone of
+// level L is the first (L + 1)^2 entries
+static look_offset_t look_cones[4][LOOK_MAX_TILES];
+
+static void look_cones_init(void)
 {
-    char response[4096];
-    strcpy(response, "[");
-    int first = 1;
-    
-    // Calculate vision range based on level
-    int range = player->level;
-    
-    for (int distance = 0; distance <= range; distance++) {
-        int width = 2 * distance + 1;
-        int start_offset = -distance;
-        
-        for (int offset = 0; offset < width; offset++) {
-            if (!first) strcat(response, ",");
-            first = 0;
-            
-            // Calculate relative position
-            int dx = 0, dy = 0;
-            int lateral = start_offset + offset;
-            
-            switch (player->orientation) {
-                case NORTH: dx = lateral; dy = -distance; break;
-                case EAST: dx = distance; dy = lateral; break;
-                case SOUTH: dx = -lateral; dy = distance; break;
-                case WEST: dx = -distance; dy = -lateral; break;
-            }
-            
-            // Get absolute position with wrapping
-            int x = map_wrap_x(server->game->map, player->x + dx);
-            int y = map_wrap_y(server->game->map, player->y + dy);
-            
-            // Get tile content
-            tile_t *tile = map_get_tile(server->game->map, x, y);
-            int first_item = 1;
-            
-            // Add players
-            for (int i = 0; i < tile->player_count; i++) {
-                if (!first_item) strcat(response, " ");
-                strcat(response, "player");
-                first_item = 0;
-            }
-            
-            // Add resources
-            for (int res = 0; res < RESOURCE_COUNT; res++) {
-                for (int count = 0; count < tile->resources[res]; count++) {
-                    if (!first_item) strcat(response, " ");
-                    strcat(response, RESOURCE_NAMES[res]);
-                    first_item = 0;
+    for (int orientation = NORTH; orientation <= WEST; orientation++) {
+        look_offset_t *cone = look_cones[orientation - 1];
+        int i = 0;
+
+        for (int distance = 0; distance <= LOOK_MAX_LEVEL; distance++) {
+            for (int lateral = -distance; lateral <= distance; lateral++) {
+                switch (orientation) {
+                    case NORTH: cone[i] = (look_offset_t){lateral, -distance}; break;
+                    case EAST: cone[i] = (look_offset_t){distance, lateral}; break;
+                    case SOUTH: cone[i] = (look_offset_t){-lateral, distance}; break;
+                    case WEST: cone[i] = (look_offset_t){-distance, -lateral}; break;
                 }
+                i++;
             }
         }
     }
+}
+
+// Cached tile text, its first space replaced by separator. Copied
+// with a single reserve when it fits in a chunk
+static bool look_write_tile(outbuf_t *out, tile_t *tile, char separator)
+{
+    size_t size = 0;
+    const char *text = tile_look_text(tile, &size);
+    char *dst = NULL;
+
+    if (!text) return false;
+    if (size == 0) return outbuf_append(out, &separator, 1);
+    if (size <= OUTBUF_CHUNK_SIZE) dst = outbuf_reserve(out, size);
+
+    if (dst) {
+        memcpy(dst, text, size);
+        *dst = separator;
+        outbuf_commit(out, size);
+        return true;
+    }
+
+    // Huge tile: across chunks
+    return outbuf_append(out, &separator, 1) && outbuf_append(out, text + 1, size - 1);
+}
+
+void cmd_look(server_t *server, client_t *client, player_t *player, const command_t *command)
+{
+    (void)command;
+    static bool cones_ready = false;
+    map_t *map = server->game->map;
+    outbuf_t *out = &client->output;
+
+    if (client->closing) return;
+    if (!cones_ready) {
+        look_cones_init();
+        cones_ready = true;
+    }
     
-    strcat(response, "]\n");
-    client_send(client, response);
+    // Calculate vision range based on level
+    int range = player->level < LOOK_MAX_LEVEL ? player->level : LOOK_MAX_LEVEL;
+    int tiles = (range + 1) * (range + 1);
+    const look_offset_t *cone = look_cones[player->orientation - 1];
+
+    // Written straight into the output queue, however full the tiles are
+    bool ok = true;
+    for (int i = 0; i < tiles && ok; i++) {
+        // Offsets are at most LOOK_MAX_LEVEL, so wrapping rarely loops
+        int x = player->x + cone[i].dx;
+        int y = player->y + cone[i].dy;
+        while (x < 0) x += map->width;
+        while (x >= map->width) x -= map->width;
+        while (y < 0) y += map->height;
+        while (y >= map->height) y -= map->height;
+
+        ok = look_write_tile(out, &map->tiles[(size_t)y * map->width + x], i > 0 ? ',' : '[');
+    }
+    ok = ok && outbuf_append(out, "]\n", 2);
+
+    if (!ok) {
+        client_close(client);
+        return;
+    }
+    client_commit(client);
 }
 
-void cmd_inventory(server_t *server, client_t *client, player_t *player)
+// "[food n,linemate n,...]": the names, separators and seven numbers
+#define INVENTORY_REPLY_MAX 160
+
+void cmd_inventory(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
-    client_send(client, "[food %d,linemate %d,deraumere %d,sibur %d,"
-                        "mendiane %d,phiras %d,thystame %d]\n",
-                 player->inventory[RES_FOOD],
-                 player->inventory[RES_LINEMATE],
-                 player->inventory[RES_DERAUMERE],
-                 player->inventory[RES_SIBUR],
-                 player->inventory[RES_MENDIANE],
-                 player->inventory[RES_PHIRAS],
-                 player->inventory[RES_THYSTAME]);
+    (void)command;
+    msg_t msg;
+
+    if (!client_begin(client, &msg, INVENTORY_REPLY_MAX)) return;
+    msg_char(&msg, '[');
+    for (int res = 0; res < RESOURCE_COUNT; res++) {
+        if (res > 0) msg_char(&msg, ',');
+        msg_str(&msg, RESOURCE_NAMES[res]);
+        msg_char(&msg, ' ');
+        msg_int(&msg, game_player_resource(server->game, player, res));
+    }
+    msg_literal(&msg, "]\n");
+    client_end(client, &msg);
 }
 
-void cmd_broadcast(server_t *server, client_t *client, player_t *player, const char *text)
+void cmd_broadcast(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    const char *text = client_command_text(client, command);
+
     broadcast_send_to_all(server->game, player, text);
-    client_send(client, "ok\n");
+    client_send_literal(client, "ok\n");
     gui_notify_broadcast(server, player->id, text);
 }
 
-void cmd_connect_nbr(server_t *server, client_t *client, player_t *player)
+void cmd_connect_nbr(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     team_t *team = server->game->teams[player->team_id];
-    client_send(client, "%d\n", team_available_slots(team));
+    msg_t msg;
+
+    if (!client_begin(client, &msg, MSG_INT_SIZE + 1)) return;
+    msg_int(&msg, team_available_slots(team));
+    msg_char(&msg, '\n');
+    client_end(client, &msg);
 }
 
-void cmd_fork(server_t *server, client_t *client, player_t *player)
+void cmd_fork(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     team_t *team = server->game->teams[player->team_id];
     
     // Create egg
-    egg_t *egg = team_add_egg(team, server->game->next_egg_id++, 
-                             player->x, player->y);
+    egg_t *egg = game_add_egg(server->game, team->id, player->x, player->y);
     if (egg) {
-        map_add_egg(server->game->map, player->x, player->y, egg->id);
         gui_notify_egg_laid(server, egg->id, player->id, player->x, player->y);
     }
     
-    client_send(client, "ok\n");
+    client_send_literal(client, "ok\n");
 }
 
-void cmd_eject(server_t *server, client_t *client, player_t *player)
+void cmd_eject(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     tile_t *tile = map_get_tile(server->game->map, player->x, player->y);
     int ejected = 0;
     
-    // Eject all other players
-    for (int i = 0; i < tile->player_count; i++) {
-        int target_id = tile->players[i];
+    // Eject all other players; walk backwards since removal swaps the
+    // last id into the current slot
+    for (int i = (int)tile->players.count - 1; i >= 0; i--) {
+        int target_id = tile_ids(&tile->players)[i];
         if (target_id == player->id) continue;
         
         player_t *target = game_get_player_by_id(server->game, target_id);
@@ -317,18 +423,17 @@ void cmd_eject(server_t *server, client_t *client, player_t *player)
         player_move_forward(target, server->game->map->width, server->game->map->height);
         target->orientation = old_orient;
         map_add_player(server->game->map, target->x, target->y, target->id);
-        
-        // Send eject message to target
-        client_t *target_client = NULL;
-        for (int j = 0; j < server->network->client_count; j++) {
-            if (server->network->clients[j]->player_id == target_id) {
-                target_client = server->network->clients[j];
-                break;
-            }
+        if (target->incantation) {
+            elevation_cancel(server->game, target->incantation, NULL);
         }
         
-        if (target_client) {
-            client_send(target_client, "eject: %d\n", push_dir);
+        // Send eject message to target
+        msg_t msg;
+        if (target->client && client_begin(target->client, &msg, MSG_INT_SIZE + 8)) {
+            msg_literal(&msg, "eject: ");
+            msg_int(&msg, push_dir);
+            msg_char(&msg, '\n');
+            client_end(target->client, &msg);
         }
         
         gui_notify_player_position(server, target);
@@ -336,83 +441,63 @@ void cmd_eject(server_t *server, client_t *client, player_t *player)
         ejected = 1;
     }
     
-    // Eject eggs
-    if (tile->egg_count > 0) {
-        // Remove all eggs
-        for (int i = 0; i < tile->egg_count; i++) {
-            int egg_id = tile->eggs[i];
-            
-            // Find and remove from teams
-            for (int t = 0; t < server->game->team_count; t++) {
-                team_remove_egg(server->game->teams[t], egg_id);
-            }
-        }
-        
-        free(tile->eggs);
-        tile->eggs = NULL;
-        tile->egg_count = 0;
+    // Destroy eggs, last first as each removal shrinks the tile's list
+    while (tile->eggs.count > 0) {
+        game_remove_egg(server->game, tile_ids(&tile->eggs)[tile->eggs.count - 1]);
         ejected = 1;
     }
     
-    client_send(client, ejected ? "ok\n" : "ko\n");
+    client_write(client, ejected ? "ok\n" : "ko\n", 3);
 }
 
-void cmd_take(server_t *server, client_t *client, player_t *player, const char *object)
+void cmd_take(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
     tile_t *tile = map_get_tile(server->game->map, player->x, player->y);
-    int res = resource_from_name(object);
+    int res = command->resource;
     
     if (res >= 0 && tile->resources[res] > 0) {
-        tile->resources[res]--;
-        player->inventory[res]++;
-        client_send(client, "ok\n");
+        map_remove_resource(server->game->map, tile, res, 1);
+        game_player_add_resource(server->game, player, res, 1);
+        client_send_literal(client, "ok\n");
         gui_notify_resource_collect(server, player->id, res);
         gui_notify_player_inventory(server, player);
         gui_notify_tile_content(server, player->x, player->y);
     } else {
-        client_send(client, "ko\n");
+        client_send_literal(client, "ko\n");
     }
 }
 
-void cmd_set(server_t *server, client_t *client, player_t *player, const char *object)
+void cmd_set(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
     tile_t *tile = map_get_tile(server->game->map, player->x, player->y);
-    int res = resource_from_name(object);
+    int res = command->resource;
     
-    if (res >= 0 && player->inventory[res] > 0) {
-        player->inventory[res]--;
-        tile->resources[res]++;
-        client_send(client, "ok\n");
+    if (res >= 0 && game_player_resource(server->game, player, res) > 0) {
+        game_player_add_resource(server->game, player, res, -1);
+        map_add_resource(server->game->map, tile, res, 1);
+        client_send_literal(client, "ok\n");
         gui_notify_resource_drop(server, player->id, res);
         gui_notify_player_inventory(server, player);
         gui_notify_tile_content(server, player->x, player->y);
     } else {
-        client_send(client, "ko\n");
+        client_send_literal(client, "ko\n");
     }
 }
 
-void cmd_incantation(server_t *server, client_t *client, player_t *player)
+void cmd_incantation(server_t *server, client_t *client, player_t *player, const command_t *command)
 {
+    (void)command;
     tile_t *tile = map_get_tile(server->game->map, player->x, player->y);
     
-    // Check if player is already incanting
-    if (player->is_incanting) {
-        client_send(client, "ko\n");
-        client_command_done(client);
+    // Already in a session, requirements unmet or out of memory: the
+    // command fails at once instead of holding the queue
+    if (player->incantation ||
+        !elevation_check_requirements(server->game, player, tile) ||
+        !elevation_start(server->game, player)) {
+        client_send_literal(client, "ko\n");
+        client_finish_action(server, client);
         return;
     }
     
-    // Check requirements
-    if (!elevation_check_requirements(server->game, player, tile)) {
-        client_send(client, "ko\n");
-        client_command_done(client);
-        return;
-    }
-    
-    // Start incantation
-    player->is_incanting = true;
-    client_send(client, "Elevation underway\n");
-    
-    // Start elevation for all eligible players
-    elevation_start(server->game, player, player->x, player->y);
-}
\ No newline at end of file
+    client_send_literal(client, "Elevation underway\n");
+}
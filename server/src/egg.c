@@ -0,0 +1,107 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Egg pool implementation
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "egg.h"
+
+static bool egg_pool_grow(egg_pool_t *pool, int capacity)
+{
+    egg_t *slots = realloc(pool->slots, capacity * sizeof(egg_t));
+    if (!slots) return false;
+    pool->slots = slots;
+
+    int *free_slots = realloc(pool->free_slots, capacity * sizeof(int));
+    if (!free_slots) return false;
+    pool->free_slots = free_slots;
+
+    // New slots go on the stack highest first, so low slots are used first
+    for (int slot = capacity - 1; slot >= pool->capacity; slot--) {
+        pool->free_slots[pool->free_count++] = slot;
+    }
+    pool->capacity = capacity;
+    return true;
+}
+
+static bool egg_pool_index(egg_pool_t *pool, int id)
+{
+    if (id < pool->id_capacity) return true;
+
+    int capacity = pool->id_capacity * 2;
+    while (capacity <= id) capacity *= 2;
+
+    int *slot_by_id = realloc(pool->slot_by_id, capacity * sizeof(int));
+    if (!slot_by_id) return false;
+    memset(slot_by_id + pool->id_capacity, 0,
+           (capacity - pool->id_capacity) * sizeof(int));
+    pool->slot_by_id = slot_by_id;
+    pool->id_capacity = capacity;
+    return true;
+}
+
+// capacity is a hint: the pool doubles past it
+egg_pool_t *egg_pool_create(int capacity)
+{
+    egg_pool_t *pool = calloc(1, sizeof(egg_pool_t));
+    if (!pool) return NULL;
+
+    if (capacity < 64) capacity = 64;
+    pool->id_capacity = capacity + 1;
+    pool->slot_by_id = calloc(pool->id_capacity, sizeof(int));
+    if (!pool->slot_by_id || !egg_pool_grow(pool, capacity)) {
+        egg_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void egg_pool_destroy(egg_pool_t *pool)
+{
+    if (!pool) return;
+
+    free(pool->slots);
+    free(pool->free_slots);
+    free(pool->slot_by_id);
+    free(pool);
+}
+
+egg_t *egg_pool_add(egg_pool_t *pool, int id, int team_id, int x, int y)
+{
+    if (id < 0 || !egg_pool_index(pool, id)) return NULL;
+    if (pool->free_count == 0 && !egg_pool_grow(pool, pool->capacity * 2)) {
+        return NULL;
+    }
+
+    int slot = pool->free_slots[--pool->free_count];
+    egg_t *egg = &pool->slots[slot];
+    egg->id = id;
+    egg->team_id = team_id;
+    egg->x = x;
+    egg->y = y;
+    egg->team_index = -1;
+    pool->slot_by_id[id] = slot + 1;
+
+    return egg;
+}
+
+egg_t *egg_pool_get(egg_pool_t *pool, int id)
+{
+    if (id < 0 || id >= pool->id_capacity || !pool->slot_by_id[id]) {
+        return NULL;
+    }
+    return &pool->slots[pool->slot_by_id[id] - 1];
+}
+
+void egg_pool_remove(egg_pool_t *pool, int id)
+{
+    if (!egg_pool_get(pool, id)) return;
+
+    pool->free_slots[pool->free_count++] = pool->slot_by_id[id] - 1;
+    pool->slot_by_id[id] = 0;
+}
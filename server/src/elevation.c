@@ -39,9 +39,9 @@ bool elevation_check_requirements(game_t *game, player_t *player, tile_t *tile)
     
     // Check player count at same level
     int player_count = 0;
-    for (int i = 0; i < tile->player_count; i++) {
-        player_t *p = game_get_player_by_id(game, tile->players[i]);
-        if (p && p->level == player->level && !p->is_incanting) {
+    for (uint32_t i = 0; i < tile->players.count; i++) {
+        player_t *p = game_get_player_by_id(game, tile_ids(&tile->players)[i]);
+        if (p && p->level == player->level && !p->incantation) {
             player_count++;
         }
     }
@@ -58,75 +58,158 @@ bool elevation_check_requirements(game_t *game, player_t *player, tile_t *tile)
     return true;
 }
 
-void elevation_start(game_t *game, player_t *initiator, int x, int y)
+// Sessions are recycled rather than freed
+static incantation_t *incantation_alloc(game_t *game)
+{
+    incantation_t *session = game->incantation_free;
+
+    if (session) {
+        game->incantation_free = session->next;
+    } else {
+        session = malloc(sizeof(incantation_t));
+        if (!session) return NULL;
+    }
+    session->count = 0;
+    session->sched_index = -1;
+    session->next = NULL;
+    return session;
+}
+
+static void incantation_release(game_t *game, incantation_t *session)
+{
+    // Detach whoever is still in it
+    for (int i = 0; i < session->count; i++) {
+        player_t *p = game_get_player_by_id(game, session->participants[i]);
+        if (p && p->incantation == session) p->incantation = NULL;
+    }
+    session->next = game->incantation_free;
+    game->incantation_free = session;
+}
+
+static void incantation_join(incantation_t *session, player_t *player)
+{
+    player->incantation = session;
+    session->participants[session->count++] = player->id;
+}
+
+// Checks the requirements are met before calling, then enlists the
+// participants and consumes the resources. Only the initiator is held
+// by its action: the others keep running commands, and completion
+// counts whoever is still on the tile at the session level. NULL if
+// out of memory
+incantation_t *elevation_start(game_t *game, player_t *initiator)
 {
     extern server_t *g_server;
-    tile_t *tile = map_get_tile(game->map, x, y);
+    tile_t *tile = map_get_tile(game->map, initiator->x, initiator->y);
     const elevation_req_t *req = &requirements[initiator->level - 1];
+    incantation_t *session = incantation_alloc(game);
+    if (!session) return NULL;
+
+    session->x = initiator->x;
+    session->y = initiator->y;
+    session->level = initiator->level;
+    session->initiator = initiator->id;
     
-    // Collect participating players
-    int *participants = malloc(req->players * sizeof(int));
-    int count = 0;
-    
-    for (int i = 0; i < tile->player_count && count < req->players; i++) {
-        player_t *p = game_get_player_by_id(game, tile->players[i]);
-        if (p && p->level == initiator->level && !p->is_incanting) {
-            p->is_incanting = true;
-            participants[count++] = p->id;
-            
-            // Send message to other participants
-            if (p->id != initiator->id) {
-                for (int j = 0; j < g_server->network->client_count; j++) {
-                    if (g_server->network->clients[j]->player_id == p->id) {
-                        client_send(g_server->network->clients[j], 
-                                   "Elevation underway\n");
-                        break;
-                    }
-                }
-            }
+    // Collect participating players, the initiator first
+    incantation_join(session, initiator);
+    for (uint32_t i = 0; i < tile->players.count && session->count < req->players; i++) {
+        player_t *p = game_get_player_by_id(game, tile_ids(&tile->players)[i]);
+        if (p && p->level == session->level && !p->incantation) {
+            incantation_join(session, p);
         }
     }
+
+    if (!scheduler_push(game->incantations, game->tick + DURATION_INCANTATION,
+                        session, &session->sched_index)) {
+        incantation_release(game, session);
+        return NULL;
+    }
+
+    // Tell the others they are taking part
+    for (int i = 1; i < session->count; i++) {
+        player_t *p = game_get_player_by_id(game, session->participants[i]);
+        if (p->client) client_send_literal(p->client, "Elevation underway\n");
+    }
     
     // Consume resources
     for (int i = 0; i < 6; i++) {
-        tile->resources[i + 1] -= req->resources[i];
+        map_remove_resource(game->map, tile, i + 1, req->resources[i]);
     }
     
     // Notify GUI
-    gui_notify_incantation_start(g_server, x, y, initiator->level, 
-                                participants, count);
-    gui_notify_tile_content(g_server, x, y);
+    gui_notify_incantation_start(g_server, session->x, session->y, session->level,
+                                session->participants, session->count);
+    gui_notify_tile_content(g_server, session->x, session->y);
     
-    free(participants);
+    return session;
 }
 
-void elevation_complete(game_t *game, player_t *player)
+// Due session: succeeds if enough participants are still on the tile
+// at the level they started from
+void elevation_complete(game_t *game, incantation_t *session)
 {
     extern server_t *g_server;
-    tile_t *tile = map_get_tile(game->map, player->x, player->y);
-    
-    // Find all participants at this location and level
-    int success = 1;
-    for (int i = 0; i < tile->player_count; i++) {
-        player_t *p = game_get_player_by_id(game, tile->players[i]);
-        if (p && p->is_incanting && p->level == player->level) {
-            p->is_incanting = false;
-            p->level++;
-            
-            // Send result to player
-            for (int j = 0; j < g_server->network->client_count; j++) {
-                if (g_server->network->clients[j]->player_id == p->id) {
-                    client_send(g_server->network->clients[j], 
-                               "Current level: %d\n", p->level);
-                    break;
-                }
+    const elevation_req_t *req = &requirements[session->level - 1];
+    player_t *players[INCANTATION_MAX_PLAYERS];
+    int present = 0;
+
+    for (int i = 0; i < session->count; i++) {
+        player_t *p = game_get_player_by_id(game, session->participants[i]);
+        if (p && p->x == session->x && p->y == session->y && p->level == session->level) {
+            players[present++] = p;
+        }
+    }
+
+    bool success = present >= req->players;
+    if (success) {
+        for (int i = 0; i < present; i++) {
+            player_t *p = players[i];
+            game_set_player_level(game, p, p->level + 1);
+            msg_t msg;
+            if (p->client && client_begin(p->client, &msg, MSG_INT_SIZE + 16)) {
+                msg_literal(&msg, "Current level: ");
+                msg_int(&msg, p->level);
+                msg_char(&msg, '\n');
+                client_end(p->client, &msg);
             }
-            
-            // Notify GUI
             gui_notify_player_level(g_server, p);
         }
+    } else {
+        player_t *initiator = game_get_player_by_id(game, session->initiator);
+        if (initiator && initiator->client) client_send_literal(initiator->client, "ko\n");
     }
     
     // Notify GUI of incantation end
-    gui_notify_incantation_end(g_server, player->x, player->y, success);
-}
\ No newline at end of file
+    gui_notify_incantation_end(g_server, session->x, session->y, success);
+    incantation_release(game, session);
+}
+
+// A participant died, left or was ejected: the incantation fails now
+// and the initiator's command ends with it
+void elevation_cancel(game_t *game, incantation_t *session, player_t *leaving)
+{
+    extern server_t *g_server;
+    player_t *initiator = game_get_player_by_id(game, session->initiator);
+
+    scheduler_remove(game->incantations, &session->sched_index);
+    if (initiator && initiator != leaving && initiator->client) {
+        client_send_literal(initiator->client, "ko\n");
+        client_finish_action(g_server, initiator->client);
+    }
+
+    gui_notify_incantation_end(g_server, session->x, session->y, 0);
+    incantation_release(game, session);
+}
+
+void elevation_destroy_all(game_t *game)
+{
+    incantation_t *session;
+
+    while ((session = scheduler_pop_due(game->incantations, UINT64_MAX)) != NULL) {
+        free(session);
+    }
+    while ((session = game->incantation_free) != NULL) {
+        game->incantation_free = session->next;
+        free(session);
+    }
+}
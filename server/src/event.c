@@ -0,0 +1,232 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Event loop backends (poll, epoll and io_uring)
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include "event.h"
+#include "client.h"
+#include "utils.h"
+#include "uring.h"
+
+static const char *backend_names[] = {
+    "poll",
+    "epoll",
+    "uring"
+};
+
+const char *event_backend_name(event_backend_t backend)
+{
+    return backend_names[backend];
+}
+
+int event_backend_from_name(const char *name)
+{
+    for (int i = 0; i < (int)(sizeof(backend_names) / sizeof(backend_names[0])); i++) {
+        if (strcmp(name, backend_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int event_init(network_t *net, event_backend_t backend)
+{
+    net->backend = backend;
+    net->epoll_fd = -1;
+
+    // io_uring watches the listen sockets with multishot accepts
+    if (backend == BACKEND_URING) {
+        net->uring = uring_create(net->listen_fds, net->listen_count);
+        return net->uring ? 0 : -1;
+    }
+
+    if (backend == BACKEND_EPOLL) {
+        net->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (net->epoll_fd < 0) return -1;
+
+        // Listen sockets stay level-triggered. data.u64 is their index:
+        // no client pointer is that small
+        for (int i = 0; i < net->listen_count; i++) {
+            struct epoll_event ev = {0};
+            ev.events = EPOLLIN;
+            ev.data.u64 = i;
+            if (epoll_ctl(net->epoll_fd, EPOLL_CTL_ADD, net->listen_fds[i], &ev) < 0) {
+                close(net->epoll_fd);
+                net->epoll_fd = -1;
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    // Poll backend: the listen sockets come first, then slot
+    // i + listen_count is clients[i]
+    net->poll_capacity = net->client_capacity + net->listen_count;
+    net->poll_fds = calloc(net->poll_capacity, sizeof(struct pollfd));
+    if (!net->poll_fds) return -1;
+    for (int i = 0; i < net->listen_count; i++) {
+        net->poll_fds[i].fd = net->listen_fds[i];
+        net->poll_fds[i].events = POLLIN;
+    }
+    net->poll_count = net->listen_count;
+    return 0;
+}
+
+void event_destroy(network_t *net)
+{
+    if (net->epoll_fd >= 0) close(net->epoll_fd);
+    free(net->poll_fds);
+    uring_destroy(net->uring);
+}
+
+static uint32_t epoll_mask(uint32_t events)
+{
+    // Edge-triggered: network_process_client_data drains until EAGAIN
+    uint32_t mask = EPOLLRDHUP | EPOLLET;
+
+    if (events & EVENT_READ) mask |= EPOLLIN;
+    if (events & EVENT_WRITE) mask |= EPOLLOUT;
+    return mask;
+}
+
+static short poll_mask(uint32_t events)
+{
+    short mask = 0;
+
+    if (events & EVENT_READ) mask |= POLLIN;
+    if (events & EVENT_WRITE) mask |= POLLOUT;
+    return mask;
+}
+
+int event_add_client(network_t *net, client_t *client)
+{
+    client->events = EVENT_READ;
+
+    if (net->backend == BACKEND_URING) {
+        return uring_add_client(net->uring, client);
+    }
+
+    if (net->backend == BACKEND_EPOLL) {
+        struct epoll_event ev = {0};
+        ev.events = epoll_mask(client->events);
+        ev.data.ptr = client;
+        return epoll_ctl(net->epoll_fd, EPOLL_CTL_ADD, client->fd, &ev);
+    }
+
+    if (net->poll_count >= net->poll_capacity) {
+        int capacity = net->poll_capacity * 2;
+        struct pollfd *fds = realloc(net->poll_fds, capacity * sizeof(struct pollfd));
+        if (!fds) return -1;
+        net->poll_fds = fds;
+        net->poll_capacity = capacity;
+    }
+
+    net->poll_fds[net->poll_count].fd = client->fd;
+    net->poll_fds[net->poll_count].events = poll_mask(client->events);
+    net->poll_fds[net->poll_count].revents = 0;
+    net->poll_count++;
+    return 0;
+}
+
+void event_update_client(network_t *net, client_t *client)
+{
+    // Read unless paused by backpressure, write only while output is pending
+    uint32_t events = 0;
+    if (!client->paused) events |= EVENT_READ;
+    if (client->output.size > 0) events |= EVENT_WRITE;
+
+    // io_uring has no interest set: receives and sends are requests
+    if (events == client->events || net->backend == BACKEND_URING) return;
+    client->events = events;
+
+    if (net->backend == BACKEND_EPOLL) {
+        struct epoll_event ev = {0};
+        ev.events = epoll_mask(events);
+        ev.data.ptr = client;
+        epoll_ctl(net->epoll_fd, EPOLL_CTL_MOD, client->fd, &ev);
+        return;
+    }
+
+    net->poll_fds[client->index + net->listen_count].events = poll_mask(events);
+}
+
+void event_remove_client(network_t *net, client_t *client)
+{
+    if (net->backend == BACKEND_URING) {
+        uring_remove_client(net->uring, client);
+        return;
+    }
+
+    if (net->backend == BACKEND_EPOLL) {
+        epoll_ctl(net->epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+        return;
+    }
+
+    // Keep poll_fds[i + listen_count] aligned with clients[i]: the caller
+    // swaps the last client into client->index, so move its slot the same way
+    net->poll_count--;
+    net->poll_fds[client->index + net->listen_count] = net->poll_fds[net->poll_count];
+}
+
+static int event_wait_epoll(network_t *net, int timeout)
+{
+    struct epoll_event events[EVENT_BATCH];
+
+    int count = epoll_wait(net->epoll_fd, events, EVENT_BATCH, timeout);
+    if (count < 0) return -1;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t flags = 0;
+        if (events[i].events & EPOLLIN) flags |= EVENT_READ;
+        if (events[i].events & EPOLLOUT) flags |= EVENT_WRITE;
+        if (events[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) flags |= EVENT_HUP;
+        net->ready[i].flags = flags;
+        if (events[i].data.u64 < LISTEN_MAX) {
+            net->ready[i].data = NULL;
+            net->ready[i].fd = net->listen_fds[events[i].data.u64];
+        } else {
+            net->ready[i].data = events[i].data.ptr;
+        }
+    }
+    return count;
+}
+
+static int event_wait_poll(network_t *net, int timeout)
+{
+    int activity = poll(net->poll_fds, net->poll_count, timeout);
+    if (activity <= 0) return activity;
+
+    // Anything beyond EVENT_BATCH is still pending on the next call
+    int count = 0;
+    for (int i = 0; i < net->poll_count && count < EVENT_BATCH; i++) {
+        short revents = net->poll_fds[i].revents;
+        if (!revents) continue;
+
+        uint32_t flags = 0;
+        if (revents & POLLIN) flags |= EVENT_READ;
+        if (revents & POLLOUT) flags |= EVENT_WRITE;
+        if (revents & (POLLHUP | POLLERR | POLLNVAL)) flags |= EVENT_HUP;
+        bool listener = i < net->listen_count;
+        net->ready[count].data = listener ? NULL : net->clients[i - net->listen_count];
+        net->ready[count].fd = net->poll_fds[i].fd;
+        net->ready[count].flags = flags;
+        count++;
+    }
+    return count;
+}
+
+int event_wait(network_t *net, int timeout)
+{
+    if (net->backend == BACKEND_EPOLL) {
+        return event_wait_epoll(net, timeout);
+    }
+    return event_wait_poll(net, timeout);
+}
@@ -12,6 +12,58 @@
 #include "game.h"
 #include "utils.h"
 #include "resources.h"
+#include "elevation.h"
+
+static bool game_index_teams(game_t *game)
+{
+    // Power of two, at most half full
+    game->team_table_size = 4;
+    while (game->team_table_size < game->team_count * 2) {
+        game->team_table_size *= 2;
+    }
+    game->team_table = calloc(game->team_table_size, sizeof(int));
+    if (!game->team_table) return false;
+
+    int mask = game->team_table_size - 1;
+    for (int i = 0; i < game->team_count; i++) {
+        int slot = str_hash(game->teams[i]->name) & mask;
+        while (game->team_table[slot] &&
+               strcmp(game->teams[game->team_table[slot] - 1]->name, game->teams[i]->name) != 0) {
+            slot = (slot + 1) & mask;
+        }
+        // Duplicate names keep the first team, as the lookup always did
+        if (!game->team_table[slot]) {
+            game->team_table[slot] = i + 1;
+        }
+    }
+    return true;
+}
+
+// Resize players and the food arrays parallel to it
+static bool game_grow_players(game_t *game, int capacity)
+{
+    player_t **players = realloc(game->players, capacity * sizeof(player_t *));
+    if (!players) return false;
+    game->players = players;
+
+    int *food = realloc(game->food, capacity * sizeof(int));
+    if (!food) return false;
+    game->food = food;
+
+    uint64_t *meal_tick = realloc(game->meal_tick, capacity * sizeof(uint64_t));
+    if (!meal_tick) return false;
+    game->meal_tick = meal_tick;
+
+    game->player_capacity = capacity;
+    return true;
+}
+
+// Tick at which life runs out with no food left: one meal is eaten
+// every LIFE_UNITS_PER_FOOD ticks from meal_tick on
+static uint64_t game_starve_tick(game_t *game, int index)
+{
+    return game->meal_tick[index] + (uint64_t)game->food[index] * LIFE_UNITS_PER_FOOD;
+}
 
 game_t *game_create(int width, int height, char **team_names, int team_count, int clients_nb)
 {
@@ -45,12 +97,23 @@ game_t *game_create(int width, int height, char **team_names, int team_count, in
     printf("DEBUG: Map created successfully\n");
     fflush(stdout);
 
+    // Initial eggs and the players hatched from them, one per team slot
+    int slots = team_count * clients_nb;
+    game->eggs = egg_pool_create(slots);
+    if (!game->eggs) {
+        printf("ERROR: Failed to create egg pool\n");
+        map_destroy(game->map);
+        free(game);
+        return NULL;
+    }
+
     // Create teams
     printf("DEBUG: Creating %d teams\n", team_count);
     fflush(stdout);
     game->teams = calloc(team_count, sizeof(team_t *));
     if (!game->teams) {
         printf("ERROR: Failed to allocate teams array\n");
+        egg_pool_destroy(game->eggs);
         map_destroy(game->map);
         free(game);
         return NULL;
@@ -68,6 +131,7 @@ game_t *game_create(int width, int height, char **team_names, int team_count, in
                 team_destroy(game->teams[j]);
             }
             free(game->teams);
+            egg_pool_destroy(game->eggs);
             map_destroy(game->map);
             free(game);
             return NULL;
@@ -79,9 +143,8 @@ game_t *game_create(int width, int height, char **team_names, int team_count, in
         for (int j = 0; j < clients_nb; j++) {
             int x = rand() % width;
             int y = rand() % height;
-            egg_t *egg = team_add_egg(game->teams[i], game->next_egg_id++, x, y);
+            egg_t *egg = game_add_egg(game, i, x, y);
             if (egg) {
-                map_add_egg(game->map, x, y, egg->id);
                 printf("DEBUG: Egg %d created at (%d,%d) for team %s\n", 
                        egg->id, x, y, team_names[i]);
             } else {
@@ -92,10 +155,19 @@ game_t *game_create(int width, int height, char **team_names, int team_count, in
     printf("DEBUG: All teams created successfully\n");
     fflush(stdout);
 
+    if (!game_index_teams(game)) {
+        printf("ERROR: Failed to allocate team index\n");
+        game_destroy(game);
+        return NULL;
+    }
+
     // Initialize players array
-    game->player_capacity = 16;
-    game->players = calloc(game->player_capacity, sizeof(player_t *));
-    if (!game->players) {
+    game->players_by_id_capacity = slots + 16;
+    game->players_by_id = calloc(game->players_by_id_capacity, sizeof(player_t *));
+    game->starvation = scheduler_create();
+    game->incantations = scheduler_create();
+    if (!game_grow_players(game, slots + 16) || !game->players_by_id ||
+        !game->starvation || !game->incantations) {
         printf("ERROR: Failed to allocate players array\n");
         game_destroy(game);
         return NULL;
@@ -129,12 +201,22 @@ void game_destroy(game_t *game)
         if (game->teams[i]) team_destroy(game->teams[i]);
     }
     free(game->teams);
+    free(game->team_table);
+    egg_pool_destroy(game->eggs);
 
-    // Destroy players
+    // Destroy players, once the heaps no longer point into them
+    if (game->incantations) {
+        elevation_destroy_all(game);
+        scheduler_destroy(game->incantations);
+    }
+    if (game->starvation) scheduler_destroy(game->starvation);
     for (int i = 0; i < game->player_count; i++) {
         if (game->players[i]) player_destroy(game->players[i]);
     }
     free(game->players);
+    free(game->food);
+    free(game->meal_tick);
+    free(game->players_by_id);
 
     if (game->winning_team) free(game->winning_team);
 
@@ -148,118 +230,223 @@ player_t *game_add_player(game_t *game, int client_id, const char *team_name)
     if (!team || team->egg_count == 0) return NULL;
 
     // Get random egg
-    egg_t *egg = team_get_random_egg(team);
+    egg_t *egg = egg_pool_get(game->eggs, team_get_random_egg(team));
     if (!egg) return NULL;
 
+    // Expand player arrays if needed
+    if (game->player_count >= game->player_capacity &&
+        !game_grow_players(game, game->player_capacity * 2)) {
+        return NULL;
+    }
+    if (game->next_player_id >= game->players_by_id_capacity) {
+        int capacity = game->players_by_id_capacity * 2;
+        player_t **by_id = realloc(game->players_by_id, capacity * sizeof(player_t *));
+        if (!by_id) return NULL;
+        memset(by_id + game->players_by_id_capacity, 0,
+               (capacity - game->players_by_id_capacity) * sizeof(player_t *));
+        game->players_by_id = by_id;
+        game->players_by_id_capacity = capacity;
+    }
+
     // Create player at egg position
     player_t *player = player_create(game->next_player_id++, client_id, 
                                     team->id, egg->x, egg->y);
     if (!player) return NULL;
 
-    // Expand player array if needed
-    if (game->player_count >= game->player_capacity) {
-        game->player_capacity *= 2;
-        game->players = realloc(game->players, 
-                               game->player_capacity * sizeof(player_t *));
+    // Add player with 10 food, on top of 10 food worth of life
+    player->index = game->player_count;
+    game->food[player->index] = 10;
+    game->meal_tick[player->index] = game->tick + 10 * LIFE_UNITS_PER_FOOD;
+    if (!scheduler_push(game->starvation, game_starve_tick(game, player->index),
+                        player, &player->starve_index)) {
+        player_destroy(player);
+        return NULL;
     }
-
-    // Add player
-    game->players[game->player_count++] = player;
+    game->players[player->index] = player;
+    game->player_count++;
+    game->players_by_id[player->id] = player;
     map_add_player(game->map, player->x, player->y, player->id);
 
     // Remove egg
-    map_remove_egg(game->map, egg->x, egg->y, egg->id);
-    team_remove_egg(team, egg->id);
+    game_remove_egg(game, egg->id);
     team->connected_clients++;
+    team->level_counts[player->level]++;
 
     return player;
 }
 
-void game_remove_player(game_t *game, int player_id)
+// Lay an egg; the pointer is valid until the next egg is added
+egg_t *game_add_egg(game_t *game, int team_id, int x, int y)
 {
-    // Find player
-    int index = -1;
-    for (int i = 0; i < game->player_count; i++) {
-        if (game->players[i]->id == player_id) {
-            index = i;
-            break;
-        }
+    egg_t *egg = egg_pool_add(game->eggs, game->next_egg_id, team_id, x, y);
+    if (!egg) return NULL;
+
+    if (!team_add_egg(game->teams[team_id], egg)) {
+        egg_pool_remove(game->eggs, egg->id);
+        return NULL;
     }
+    map_add_egg(game->map, x, y, egg->id);
+    game->next_egg_id++;
+    return egg;
+}
 
-    if (index < 0) return;
+// Drop an egg from its tile, its team and the pool, once hatched or
+// destroyed
+void game_remove_egg(game_t *game, int egg_id)
+{
+    egg_t *egg = egg_pool_get(game->eggs, egg_id);
+    if (!egg) return;
 
-    player_t *player = game->players[index];
-    
-    // Remove from map
+    map_remove_egg(game->map, egg->x, egg->y, egg->id);
+    team_remove_egg(game->teams[egg->team_id], game->eggs, egg);
+    egg_pool_remove(game->eggs, egg_id);
+}
+
+// Move a player and its food state to another slot
+static void game_move_player(game_t *game, int from, int to)
+{
+    game->players[to] = game->players[from];
+    game->players[to]->index = to;
+    game->food[to] = game->food[from];
+    game->meal_tick[to] = game->meal_tick[from];
+}
+
+// Free a player, leaving its slot in game->players to the caller
+static void game_release_player(game_t *game, player_t *player)
+{
+    // Remove from map and from the starvation heap; its incantation
+    // cannot go on without it
     map_remove_player(game->map, player->x, player->y, player->id);
+    scheduler_remove(game->starvation, &player->starve_index);
+    if (player->incantation) elevation_cancel(game, player->incantation, player);
     
     // Update team
     if (player->team_id >= 0 && player->team_id < game->team_count) {
         game->teams[player->team_id]->connected_clients--;
+        game->teams[player->team_id]->level_counts[player->level]--;
     }
     
     // Drop inventory
     tile_t *tile = map_get_tile(game->map, player->x, player->y);
     for (int i = 0; i < RESOURCE_COUNT; i++) {
-        tile->resources[i] += player->inventory[i];
+        map_add_resource(game->map, tile, i, game_player_resource(game, player, i));
     }
     
     // Destroy player
+    game->players_by_id[player->id] = NULL;
     player_destroy(player);
+}
+
+void game_remove_player(game_t *game, int player_id)
+{
+    player_t *player = game_get_player_by_id(game, player_id);
+    if (!player) return;
+
+    int index = player->index;
+    game_release_player(game, player);
     
-    // Remove from array
-    for (int i = index; i < game->player_count - 1; i++) {
-        game->players[i] = game->players[i + 1];
-    }
+    // Swap the last player into the hole
     game->player_count--;
+    if (index < game->player_count) {
+        game_move_player(game, game->player_count, index);
+    }
 }
 
 team_t *game_get_team_by_name(game_t *game, const char *name)
 {
-    for (int i = 0; i < game->team_count; i++) {
-        if (strcmp(game->teams[i]->name, name) == 0) {
-            return game->teams[i];
+    int mask = game->team_table_size - 1;
+    int slot = str_hash(name) & mask;
+
+    while (game->team_table[slot]) {
+        team_t *team = game->teams[game->team_table[slot] - 1];
+        if (strcmp(team->name, name) == 0) {
+            return team;
         }
+        slot = (slot + 1) & mask;
     }
     return NULL;
 }
 
 player_t *game_get_player_by_id(game_t *game, int player_id)
 {
-    for (int i = 0; i < game->player_count; i++) {
-        if (game->players[i]->id == player_id) {
-            return game->players[i];
-        }
+    if (player_id < 0 || player_id >= game->players_by_id_capacity) {
+        return NULL;
     }
-    return NULL;
+    return game->players_by_id[player_id];
 }
 
-player_t *game_get_player_by_client_id(game_t *game, int client_id)
+// Apply the meals eaten since the stored food count; a live player
+// always has food left for them
+static void game_settle_food(game_t *game, int index)
 {
-    for (int i = 0; i < game->player_count; i++) {
-        if (game->players[i]->client_id == client_id) {
-            return game->players[i];
-        }
+    uint64_t meal = game->meal_tick[index];
+
+    if (game->tick < meal) return;
+
+    // A starving player has eaten its last unit, it owes none
+    int meals = (game->tick - meal) / LIFE_UNITS_PER_FOOD + 1;
+    if (meals > game->food[index]) meals = game->food[index];
+    game->food[index] -= meals;
+    game->meal_tick[index] = meal + (uint64_t)meals * LIFE_UNITS_PER_FOOD;
+}
+
+int game_player_resource(game_t *game, player_t *player, int resource)
+{
+    if (resource == RES_FOOD) {
+        game_settle_food(game, player->index);
+        return game->food[player->index];
     }
-    return NULL;
+    return player->inventory[resource];
 }
 
-void game_tick(game_t *game, int freq)
+// Food moves the player's starvation tick, so it is rescheduled
+void game_player_add_resource(game_t *game, player_t *player, int resource, int amount)
 {
-    // Update all players
-    for (int i = 0; i < game->player_count; i++) {
-        player_t *player = game->players[i];
-        
-        // Consume life
-        player_consume_life(player);
+    if (resource != RES_FOOD) {
+        player->inventory[resource] += amount;
+        return;
     }
-    
-    // Remove dead players
-    for (int i = game->player_count - 1; i >= 0; i--) {
-        if (game->players[i]->is_dead) {
-            log_info("Player %d died", game->players[i]->id);
-            game_remove_player(game, game->players[i]->id);
-        }
+
+    game_settle_food(game, player->index);
+    game->food[player->index] += amount;
+    scheduler_update(game->starvation, &player->starve_index,
+                     game_starve_tick(game, player->index));
+}
+
+// Levels change only through here, so the team histograms stay exact
+// and victory fires on the level-up that completes a team
+void game_set_player_level(game_t *game, player_t *player, int level)
+{
+    team_t *team = game->teams[player->team_id];
+
+    if (level > MAX_LEVEL) level = MAX_LEVEL;
+    team->level_counts[player->level]--;
+    team->level_counts[level]++;
+    player->level = level;
+
+    if (level == MAX_LEVEL && !game->game_won &&
+        team->level_counts[MAX_LEVEL] >= VICTORY_PLAYERS) {
+        game->game_won = true;
+        game->winning_team = strdup(team->name);
+    }
+}
+
+void game_tick(game_t *game)
+{
+    player_t *player;
+    incantation_t *session;
+
+    game->tick++;
+
+    // Only players starving on this tick come out of the heap
+    while ((player = scheduler_pop_due(game->starvation, game->tick)) != NULL) {
+        log_info("Player %d died", player->id);
+        game_remove_player(game, player->id);
+    }
+
+    // Then incantations ending on this tick, with their survivors
+    while ((session = scheduler_pop_due(game->incantations, game->tick)) != NULL) {
+        elevation_complete(game, session);
     }
     
     // Spawn resources every 20 time units
@@ -273,53 +460,49 @@ void game_tick(game_t *game, int freq)
 
 bool game_check_victory(game_t *game)
 {
-    // Check each team
-    for (int i = 0; i < game->team_count; i++) {
-        int level8_count = 0;
-        
-        // Count level 8 players
-        for (int j = 0; j < game->player_count; j++) {
-            if (game->players[j]->team_id == i && 
-                game->players[j]->level >= 8) {
-                level8_count++;
-            }
-        }
-        
-        // Victory condition: 6 players at level 8
-        if (level8_count >= 6) {
-            game->game_won = true;
-            game->winning_team = strdup(game->teams[i]->name);
-            return true;
-        }
+    // Set by game_set_player_level as soon as a team qualifies
+    return game->game_won;
+}
+
+// xorshift64*, much cheaper per draw than rand()
+static uint64_t game_random(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ull;
+}
+
+// Place count units on uniformly random tiles. Each 64-bit draw places
+// two: its halves map onto [0, tiles) with a multiply instead of a modulo
+// (a map cannot reach 2^32 tiles in memory)
+static void spawn_scattered(map_t *map, int res, int64_t count, uint64_t *state)
+{
+    uint64_t total_tiles = (uint64_t)map->width * map->height;
+
+    while (count > 0) {
+        uint64_t bits = game_random(state);
+        uint64_t index = ((bits >> 32) * total_tiles) >> 32;
+        map_add_resource(map, &map->tiles[index], res, 1);
+        if (--count == 0) break;
+        index = ((bits & 0xffffffffu) * total_tiles) >> 32;
+        map_add_resource(map, &map->tiles[index], res, 1);
+        count--;
     }
-    
-    return false;
 }
 
 void game_spawn_resources(game_t *game)
 {
-    int total_tiles = game->map->width * game->map->height;
+    map_t *map = game->map;
+    int64_t total_tiles = (int64_t)map->width * map->height;
+
+    // Reseed from rand() so srand() still drives the world
+    uint64_t state = ((uint64_t)rand() << 32 | (uint64_t)rand()) | 1;
     
     for (int res = 0; res < RESOURCE_COUNT; res++) {
-        int target = (int)(total_tiles * RESOURCE_DENSITY[res]);
-        int current = 0;
-        
-        // Count current resources
-        for (int y = 0; y < game->map->height; y++) {
-            for (int x = 0; x < game->map->width; x++) {
-                tile_t *tile = map_get_tile(game->map, x, y);
-                current += tile->resources[res];
-            }
-        }
-        
-        // Spawn missing resources
-        int to_spawn = target - current;
-        while (to_spawn > 0) {
-            int x = rand() % game->map->width;
-            int y = rand() % game->map->height;
-            tile_t *tile = map_get_tile(game->map, x, y);
-            tile->resources[res]++;
-            to_spawn--;
-        }
+        int64_t target = (int64_t)(total_tiles * RESOURCE_DENSITY[res]);
+
+        // Running totals give the deficit without scanning the map
+        spawn_scattered(map, res, target - map->totals[res], &state);
     }
-}
\ No newline at end of file
+}
@@ -5,10 +5,11 @@
 ** GUI protocol implementation
 */
 
-#include <stdio.h>
 #include <stdlib.h>
-#include <stdarg.h>
 #include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <stdbool.h>
 #include "server.h"
 #include "gui_protocol.h"
 #include "client.h"
@@ -17,239 +18,432 @@
 #include "map.h"
 #include "team.h"
 
-void network_send_to_all_gui(network_t *network, const char *format, ...)
+// Longest line made only of numbers ("pin" and its ten values)
+#define GUI_LINE_MAX 128
+#define GUI_BCT_MAX (4 + 2 * (MSG_INT_SIZE + 1) + TILE_BCT_MAX)
+
+// The line is built once and copied to each GUI
+void network_send_to_all_gui(network_t *network, const msg_t *msg)
 {
-    char buffer[BUFFER_SIZE];
-    va_list args;
-    
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+    if (msg->truncated) return;
 
     for (int i = 0; i < network->client_count; i++) {
         if (network->clients[i]->type == CLIENT_GUI) {
-            client_send(network->clients[i], "%s", buffer);
+            client_write(network->clients[i], msg->data, msg->len);
         }
     }
 }
 
+// " v1 v2 ..." for each value
+static void gui_append_ints(msg_t *msg, const int *values, int count)
+{
+    for (int i = 0; i < count; i++) {
+        msg_char(msg, ' ');
+        msg_int(msg, values[i]);
+    }
+}
+
+// "<word> #<id>", the start of player and egg lines
+static void gui_begin_id(msg_t *msg, const char *word, int id)
+{
+    msg_append(msg, word, 3);
+    msg_literal(msg, " #");
+    msg_int(msg, id);
+}
+
+static void gui_format_ppo(msg_t *msg, player_t *player)
+{
+    int values[3] = {player->x, player->y, player->orientation};
+
+    gui_begin_id(msg, "ppo", player->id);
+    gui_append_ints(msg, values, 3);
+    msg_char(msg, '\n');
+}
+
+static void gui_format_plv(msg_t *msg, player_t *player)
+{
+    gui_begin_id(msg, "plv", player->id);
+    msg_char(msg, ' ');
+    msg_int(msg, player->level);
+    msg_char(msg, '\n');
+}
+
+static void gui_format_pin(msg_t *msg, game_t *game, player_t *player)
+{
+    int values[2 + RESOURCE_COUNT] = {player->x, player->y};
+
+    values[2 + RES_FOOD] = game_player_resource(game, player, RES_FOOD);
+    for (int res = RES_FOOD + 1; res < RESOURCE_COUNT; res++) {
+        values[2 + res] = player->inventory[res];
+    }
+    gui_begin_id(msg, "pin", player->id);
+    gui_append_ints(msg, values, 2 + RESOURCE_COUNT);
+    msg_char(msg, '\n');
+}
+
+static void gui_format_pnw(msg_t *msg, game_t *game, player_t *player)
+{
+    int values[4] = {player->x, player->y, player->orientation, player->level};
+
+    gui_begin_id(msg, "pnw", player->id);
+    gui_append_ints(msg, values, 4);
+    msg_char(msg, ' ');
+    msg_str(msg, game->teams[player->team_id]->name);
+    msg_char(msg, '\n');
+}
+
+// "<word> #<id>\n"
+static void gui_notify_id(server_t *server, const char *word, int id)
+{
+    char buffer[GUI_LINE_MAX];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_begin_id(&msg, word, id);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
+}
+
+// "<word> #<id> <value>\n"
+static void gui_notify_id_value(server_t *server, const char *word,
+                                int id, int value)
+{
+    char buffer[GUI_LINE_MAX];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_begin_id(&msg, word, id);
+    msg_char(&msg, ' ');
+    msg_int(&msg, value);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
+}
+
 // GUI Command handlers
 void gui_cmd_msz(server_t *server, client_t *client)
 {
-    client_send(client, "msz %d %d\n", 
-                 server->game->map->width, 
-                 server->game->map->height);
+    msg_t msg;
+
+    if (!client_begin(client, &msg, GUI_LINE_MAX)) return;
+    msg_literal(&msg, "msz ");
+    msg_int(&msg, server->game->map->width);
+    msg_char(&msg, ' ');
+    msg_int(&msg, server->game->map->height);
+    msg_char(&msg, '\n');
+    client_end(client, &msg);
+}
+
+// Full bct line for a tile. The counts come from the tile's cached text;
+// uncached tiles are formatted directly unless asked to fill the cache
+static void gui_format_bct(msg_t *msg, tile_t *tile, int x, int y, bool cache)
+{
+    size_t len = 0;
+    const char *counts = NULL;
+
+    msg_literal(msg, "bct ");
+    msg_int(msg, x);
+    msg_char(msg, ' ');
+    msg_int(msg, y);
+    msg_char(msg, ' ');
+
+    if (cache || (tile->text && (tile->text->valid & TILE_TEXT_BCT))) {
+        counts = tile_bct_text(tile, &len);
+    }
+    if (counts) {
+        msg_append(msg, counts, len);
+    } else if (msg->capacity - msg->len >= TILE_BCT_MAX) {
+        msg->len += tile_format_bct(tile, msg->data + msg->len);
+    } else {
+        msg->truncated = true;
+    }
 }
 
 void gui_cmd_bct(server_t *server, client_t *client, int x, int y)
 {
+    msg_t msg;
+
     if (x < 0 || x >= server->game->map->width ||
         y < 0 || y >= server->game->map->height) {
-        client_send(client, "sbp\n");
+        client_send_literal(client, "sbp\n");
         return;
     }
     
     tile_t *tile = map_get_tile(server->game->map, x, y);
-    client_send(client, "bct %d %d %d %d %d %d %d %d %d\n",
-                 x, y,
-                 tile->resources[RES_FOOD],
-                 tile->resources[RES_LINEMATE],
-                 tile->resources[RES_DERAUMERE],
-                 tile->resources[RES_SIBUR],
-                 tile->resources[RES_MENDIANE],
-                 tile->resources[RES_PHIRAS],
-                 tile->resources[RES_THYSTAME]);
+    if (!client_begin(client, &msg, GUI_BCT_MAX)) return;
+    gui_format_bct(&msg, tile, x, y, true);
+    client_end(client, &msg);
 }
 
+// Whole map: cached tiles are reused, the rest formatted without
+// allocating a cache entry for every tile
 void gui_cmd_mct(server_t *server, client_t *client)
 {
-    for (int y = 0; y < server->game->map->height; y++) {
-        for (int x = 0; x < server->game->map->width; x++) {
-            gui_cmd_bct(server, client, x, y);
+    map_t *map = server->game->map;
+    msg_t msg;
+
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            tile_t *tile = &map->tiles[(size_t)y * map->width + x];
+            if (!client_begin(client, &msg, GUI_BCT_MAX)) return;
+            gui_format_bct(&msg, tile, x, y, false);
+            client_end(client, &msg);
         }
     }
 }
 
 void gui_cmd_tna(server_t *server, client_t *client)
 {
+    msg_t msg;
+
     for (int i = 0; i < server->game->team_count; i++) {
-        client_send(client, "tna %s\n", server->game->teams[i]->name);
+        const char *name = server->game->teams[i]->name;
+        if (!client_begin(client, &msg, strlen(name) + 5)) return;
+        msg_literal(&msg, "tna ");
+        msg_str(&msg, name);
+        msg_char(&msg, '\n');
+        client_end(client, &msg);
     }
 }
 
 void gui_cmd_ppo(server_t *server, client_t *client, int n)
 {
     player_t *player = game_get_player_by_id(server->game, n);
+    msg_t msg;
+
     if (!player) {
-        client_send(client, "sbp\n");
+        client_send_literal(client, "sbp\n");
         return;
     }
     
-    client_send(client, "ppo #%d %d %d %d\n",
-                 player->id, player->x, player->y, player->orientation);
+    if (!client_begin(client, &msg, GUI_LINE_MAX)) return;
+    gui_format_ppo(&msg, player);
+    client_end(client, &msg);
 }
 
 void gui_cmd_plv(server_t *server, client_t *client, int n)
 {
     player_t *player = game_get_player_by_id(server->game, n);
+    msg_t msg;
+
     if (!player) {
-        client_send(client, "sbp\n");
+        client_send_literal(client, "sbp\n");
         return;
     }
     
-    client_send(client, "plv #%d %d\n", player->id, player->level);
+    if (!client_begin(client, &msg, GUI_LINE_MAX)) return;
+    gui_format_plv(&msg, player);
+    client_end(client, &msg);
 }
 
 void gui_cmd_pin(server_t *server, client_t *client, int n)
 {
     player_t *player = game_get_player_by_id(server->game, n);
+    msg_t msg;
+
     if (!player) {
-        client_send(client, "sbp\n");
+        client_send_literal(client, "sbp\n");
         return;
     }
     
-    client_send(client, "pin #%d %d %d %d %d %d %d %d %d %d\n",
-                 player->id, player->x, player->y,
-                 player->inventory[RES_FOOD],
-                 player->inventory[RES_LINEMATE],
-                 player->inventory[RES_DERAUMERE],
-                 player->inventory[RES_SIBUR],
-                 player->inventory[RES_MENDIANE],
-                 player->inventory[RES_PHIRAS],
-                 player->inventory[RES_THYSTAME]);
+    if (!client_begin(client, &msg, GUI_LINE_MAX)) return;
+    gui_format_pin(&msg, server->game, player);
+    client_end(client, &msg);
 }
 
 void gui_cmd_sgt(server_t *server, client_t *client)
 {
-    client_send(client, "sgt %d\n", server->config->freq);
+    msg_t msg;
+
+    if (!client_begin(client, &msg, GUI_LINE_MAX)) return;
+    msg_literal(&msg, "sgt ");
+    msg_int(&msg, server->config->freq);
+    msg_char(&msg, '\n');
+    client_end(client, &msg);
 }
 
 void gui_cmd_sst(server_t *server, client_t *client, int time)
 {
+    char buffer[GUI_LINE_MAX];
+    msg_t msg;
+
     if (time < 2 || time > 10000) {
-        client_send(client, "sbp\n");
+        client_send_literal(client, "sbp\n");
         return;
     }
     
-    server->config->freq = time;
-    network_send_to_all_gui(server->network, "sst %d\n", time);
+    server_set_freq(server, time);
+    msg_init(&msg, buffer, sizeof(buffer));
+    msg_literal(&msg, "sst ");
+    msg_int(&msg, time);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
+}
+
+// Extension: each team's player count per level, one
+// "tlv <team> <level 1> ... <level 8>" line per team
+void gui_cmd_tlv(server_t *server, client_t *client)
+{
+    msg_t msg;
+
+    for (int i = 0; i < server->game->team_count; i++) {
+        team_t *team = server->game->teams[i];
+        if (!client_begin(client, &msg, strlen(team->name) + GUI_LINE_MAX)) return;
+        msg_literal(&msg, "tlv ");
+        msg_str(&msg, team->name);
+        gui_append_ints(&msg, team->level_counts + 1, MAX_LEVEL);
+        msg_char(&msg, '\n');
+        client_end(client, &msg);
+    }
 }
 
 // GUI Notifications
 void gui_notify_player_connect(server_t *server, player_t *player)
 {
-    network_send_to_all_gui(server->network, "pnw #%d %d %d %d %d %s\n",
-                           player->id, player->x, player->y,
-                           player->orientation, player->level,
-                           server->game->teams[player->team_id]->name);
+    char buffer[BUFFER_SIZE];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_format_pnw(&msg, server->game, player);
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_player_position(server_t *server, player_t *player)
 {
-    network_send_to_all_gui(server->network, "ppo #%d %d %d %d\n",
-                           player->id, player->x, player->y, player->orientation);
+    char buffer[GUI_LINE_MAX];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_format_ppo(&msg, player);
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_player_inventory(server_t *server, player_t *player)
 {
-    network_send_to_all_gui(server->network, 
-                           "pin #%d %d %d %d %d %d %d %d %d %d\n",
-                           player->id, player->x, player->y,
-                           player->inventory[RES_FOOD],
-                           player->inventory[RES_LINEMATE],
-                           player->inventory[RES_DERAUMERE],
-                           player->inventory[RES_SIBUR],
-                           player->inventory[RES_MENDIANE],
-                           player->inventory[RES_PHIRAS],
-                           player->inventory[RES_THYSTAME]);
+    char buffer[GUI_LINE_MAX];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_format_pin(&msg, server->game, player);
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_player_level(server_t *server, player_t *player)
 {
-    network_send_to_all_gui(server->network, "plv #%d %d\n",
-                           player->id, player->level);
+    gui_notify_id_value(server, "plv", player->id, player->level);
 }
 
 void gui_notify_player_death(server_t *server, int player_id)
 {
-    network_send_to_all_gui(server->network, "pdi #%d\n", player_id);
+    gui_notify_id(server, "pdi", player_id);
 }
 
 void gui_notify_egg_laid(server_t *server, int egg_id, int player_id, int x, int y)
 {
-    network_send_to_all_gui(server->network, "pfk #%d\n", player_id);
-    network_send_to_all_gui(server->network, "enw #%d #%d %d %d\n",
-                           egg_id, player_id, x, y);
+    char buffer[GUI_LINE_MAX];
+    int values[2] = {x, y};
+    msg_t msg;
+
+    gui_notify_id(server, "pfk", player_id);
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_begin_id(&msg, "enw", egg_id);
+    msg_literal(&msg, " #");
+    msg_int(&msg, player_id);
+    gui_append_ints(&msg, values, 2);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_egg_connect(server_t *server, int egg_id)
 {
-    network_send_to_all_gui(server->network, "ebo #%d\n", egg_id);
+    gui_notify_id(server, "ebo", egg_id);
 }
 
 void gui_notify_resource_collect(server_t *server, int player_id, int resource)
 {
-    network_send_to_all_gui(server->network, "pgt #%d %d\n",
-                           player_id, resource);
+    gui_notify_id_value(server, "pgt", player_id, resource);
 }
 
 void gui_notify_resource_drop(server_t *server, int player_id, int resource)
 {
-    network_send_to_all_gui(server->network, "pdr #%d %d\n",
-                           player_id, resource);
+    gui_notify_id_value(server, "pdr", player_id, resource);
 }
 
 void gui_notify_broadcast(server_t *server, int player_id, const char *message)
 {
-    network_send_to_all_gui(server->network, "pbc #%d %s\n",
-                           player_id, message);
+    char buffer[BUFFER_SIZE];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_begin_id(&msg, "pbc", player_id);
+    msg_char(&msg, ' ');
+    msg_str(&msg, message);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_incantation_start(server_t *server, int x, int y, int level,
                                  int *players, int count)
 {
-    char buffer[1024];
-    int len = snprintf(buffer, sizeof(buffer), "pic %d %d %d", x, y, level);
-    
+    char buffer[BUFFER_SIZE];
+    int values[3] = {x, y, level};
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    msg_literal(&msg, "pic");
+    gui_append_ints(&msg, values, 3);
     for (int i = 0; i < count; i++) {
-        len += snprintf(buffer + len, sizeof(buffer) - len, " #%d", players[i]);
+        msg_literal(&msg, " #");
+        msg_int(&msg, players[i]);
     }
-    
-    network_send_to_all_gui(server->network, "%s\n", buffer);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_incantation_end(server_t *server, int x, int y, int result)
 {
-    network_send_to_all_gui(server->network, "pie %d %d %d\n", x, y, result);
+    char buffer[GUI_LINE_MAX];
+    int values[3] = {x, y, result};
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    msg_literal(&msg, "pie");
+    gui_append_ints(&msg, values, 3);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_game_end(server_t *server, const char *team)
 {
-    network_send_to_all_gui(server->network, "seg %s\n", team);
+    char buffer[BUFFER_SIZE];
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    msg_literal(&msg, "seg ");
+    msg_str(&msg, team);
+    msg_char(&msg, '\n');
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_tile_content(server_t *server, int x, int y)
 {
+    char buffer[GUI_BCT_MAX];
     tile_t *tile = map_get_tile(server->game->map, x, y);
-    network_send_to_all_gui(server->network, 
-                           "bct %d %d %d %d %d %d %d %d %d\n",
-                           x, y,
-                           tile->resources[RES_FOOD],
-                           tile->resources[RES_LINEMATE],
-                           tile->resources[RES_DERAUMERE],
-                           tile->resources[RES_SIBUR],
-                           tile->resources[RES_MENDIANE],
-                           tile->resources[RES_PHIRAS],
-                           tile->resources[RES_THYSTAME]);
+    msg_t msg;
+
+    msg_init(&msg, buffer, sizeof(buffer));
+    gui_format_bct(&msg, tile, x, y, true);
+    network_send_to_all_gui(server->network, &msg);
 }
 
 void gui_notify_expulsion(server_t *server, int player_id)
 {
-    network_send_to_all_gui(server->network, "pex #%d\n", player_id);
+    gui_notify_id(server, "pex", player_id);
 }
 
 void gui_send_initial_data(server_t *server, client_t *client)
 {
+    msg_t msg;
+
     // Send map size
     gui_cmd_msz(server, client);
     
@@ -265,12 +459,12 @@ void gui_send_initial_data(server_t *server, client_t *client)
     // Send all players
     for (int i = 0; i < server->game->player_count; i++) {
         player_t *player = server->game->players[i];
+        const char *team = server->game->teams[player->team_id]->name;
         
         // Player connection
-        client_send(client, "pnw #%d %d %d %d %d %s\n",
-                    player->id, player->x, player->y,
-                    player->orientation, player->level,
-                    server->game->teams[player->team_id]->name);
+        if (!client_begin(client, &msg, strlen(team) + GUI_LINE_MAX)) return;
+        gui_format_pnw(&msg, server->game, player);
+        client_end(client, &msg);
         
         // Player inventory
         gui_cmd_pin(server, client, player->id);
@@ -282,61 +476,145 @@ void gui_send_initial_data(server_t *server, client_t *client)
     // Send all eggs
     for (int i = 0; i < server->game->team_count; i++) {
         team_t *team = server->game->teams[i];
-        egg_t *egg = team->eggs;
-        while (egg) {
-            client_send(client, "enw #%d #%d %d %d\n",
-                        egg->id, 0, egg->x, egg->y);
-            egg = egg->next;
+        for (int j = 0; j < team->egg_count; j++) {
+            egg_t *egg = egg_pool_get(server->game->eggs, team->egg_ids[j]);
+            if (!client_begin(client, &msg, GUI_LINE_MAX)) return;
+            gui_begin_id(&msg, "enw", egg->id);
+            msg_literal(&msg, " #0 ");
+            msg_int(&msg, egg->x);
+            msg_char(&msg, ' ');
+            msg_int(&msg, egg->y);
+            msg_char(&msg, '\n');
+            client_end(client, &msg);
+        }
+    }
+}
+
+// GUI command opcodes, indexes into gui_commands
+typedef enum {
+    GUI_MSZ = 0,
+    GUI_BCT,
+    GUI_MCT,
+    GUI_TNA,
+    GUI_PPO,
+    GUI_PLV,
+    GUI_PIN,
+    GUI_SGT,
+    GUI_SST,
+    GUI_TLV,
+    GUI_UNKNOWN
+} gui_opcode_t;
+
+// GUI command word and the shape of its arguments
+typedef struct gui_command_def_s {
+    char name[4];
+    int argc;
+    bool player;  // argument is written #n
+} gui_command_def_t;
+
+static const gui_command_def_t gui_commands[GUI_UNKNOWN] = {
+    [GUI_MSZ] = {"msz", 0, false},
+    [GUI_BCT] = {"bct", 2, false},
+    [GUI_MCT] = {"mct", 0, false},
+    [GUI_TNA] = {"tna", 0, false},
+    [GUI_PPO] = {"ppo", 1, true},
+    [GUI_PLV] = {"plv", 1, true},
+    [GUI_PIN] = {"pin", 1, true},
+    [GUI_SGT] = {"sgt", 0, false},
+    [GUI_SST] = {"sst", 1, false},
+    [GUI_TLV] = {"tlv", 0, false},
+};
+
+static bool gui_parse_int(const char **cursor, const char *end, int *value)
+{
+    const char *p = *cursor;
+    bool negative = false;
+    long result = 0;
+
+    while (p < end && isspace((unsigned char)*p)) p++;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || !isdigit((unsigned char)*p)) return false;
+
+    while (p < end && isdigit((unsigned char)*p)) {
+        if (result <= INT_MAX) result = result * 10 + (*p - '0');
+        p++;
+    }
+    if (result > INT_MAX) result = INT_MAX;
+
+    *value = negative ? -(int)result : (int)result;
+    *cursor = p;
+    return true;
+}
+
+// Returns GUI_UNKNOWN for an unknown word, -1 for bad arguments
+static int gui_decode(const char *line, size_t len, int args[2])
+{
+    const char *end = line + len;
+    const char *p = line;
+
+    while (p < end && !isspace((unsigned char)*p)) p++;
+    if (p - line != 3) return GUI_UNKNOWN;
+
+    for (int op = 0; op < GUI_UNKNOWN; op++) {
+        const gui_command_def_t *def = &gui_commands[op];
+        if (memcmp(def->name, line, 3) != 0) continue;
+
+        for (int i = 0; i < def->argc; i++) {
+            if (def->player) {
+                while (p < end && isspace((unsigned char)*p)) p++;
+                if (p == end || *p != '#') return -1;
+                p++;
+            }
+            if (!gui_parse_int(&p, end, &args[i])) return -1;
         }
+        return op;
     }
+    return GUI_UNKNOWN;
 }
 
-void process_gui_command(server_t *server, client_t *client, const char *command)
+void process_gui_command(server_t *server, client_t *client, const char *command, size_t len)
 {
-    char cmd[256];
-    int x, y, n, time;
-    
-    sscanf(command, "%255s", cmd);
-    
-    if (strcmp(cmd, "msz") == 0) {
+    int args[2];
+
+    switch (gui_decode(command, len, args)) {
+    case GUI_MSZ:
         gui_cmd_msz(server, client);
-    } else if (strcmp(cmd, "bct") == 0) {
-        if (sscanf(command, "bct %d %d", &x, &y) == 2) {
-            gui_cmd_bct(server, client, x, y);
-        } else {
-            client_send(client, "sbp\n");
-        }
-    } else if (strcmp(cmd, "mct") == 0) {
+        break;
+    case GUI_BCT:
+        gui_cmd_bct(server, client, args[0], args[1]);
+        break;
+    case GUI_MCT:
         gui_cmd_mct(server, client);
-    } else if (strcmp(cmd, "tna") == 0) {
+        break;
+    case GUI_TNA:
         gui_cmd_tna(server, client);
-    } else if (strcmp(cmd, "ppo") == 0) {
-        if (sscanf(command, "ppo #%d", &n) == 1) {
-            gui_cmd_ppo(server, client, n);
-        } else {
-            client_send(client, "sbp\n");
-        }
-    } else if (strcmp(cmd, "plv") == 0) {
-        if (sscanf(command, "plv #%d", &n) == 1) {
-            gui_cmd_plv(server, client, n);
-        } else {
-            client_send(client, "sbp\n");
-        }
-    } else if (strcmp(cmd, "pin") == 0) {
-        if (sscanf(command, "pin #%d", &n) == 1) {
-            gui_cmd_pin(server, client, n);
-        } else {
-            client_send(client, "sbp\n");
-        }
-    } else if (strcmp(cmd, "sgt") == 0) {
+        break;
+    case GUI_PPO:
+        gui_cmd_ppo(server, client, args[0]);
+        break;
+    case GUI_PLV:
+        gui_cmd_plv(server, client, args[0]);
+        break;
+    case GUI_PIN:
+        gui_cmd_pin(server, client, args[0]);
+        break;
+    case GUI_SGT:
         gui_cmd_sgt(server, client);
-    } else if (strcmp(cmd, "sst") == 0) {
-        if (sscanf(command, "sst %d", &time) == 1) {
-            gui_cmd_sst(server, client, time);
-        } else {
-            client_send(client, "sbp\n");
-        }
-    } else {
-        client_send(client, "suc\n");
+        break;
+    case GUI_SST:
+        gui_cmd_sst(server, client, args[0]);
+        break;
+    case GUI_TLV:
+        gui_cmd_tlv(server, client);
+        break;
+    case GUI_UNKNOWN:
+        client_send_literal(client, "suc\n");
+        break;
+    default:
+        client_send_literal(client, "sbp\n");
+        break;
     }
-}
\ No newline at end of file
+}
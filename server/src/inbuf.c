@@ -0,0 +1,95 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Line-framed input buffer implementation
+*/
+
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include "inbuf.h"
+
+// Makes room at the end of the buffer, returns how much there is
+static size_t inbuf_reclaim(inbuf_t *in)
+{
+    // Reclaim consumed bytes before reading more
+    if (in->start == in->size) {
+        in->start = 0;
+        in->scan = 0;
+        in->size = 0;
+    } else if (in->size == INBUF_SIZE && in->start > 0) {
+        size_t pending = in->size - in->start;
+        memmove(in->data, in->data + in->start, pending);
+        in->scan -= in->start;
+        in->start = 0;
+        in->size = pending;
+    }
+
+    // A full buffer without a newline is an overlong line: drop it
+    if (in->size == INBUF_SIZE) {
+        in->start = 0;
+        in->scan = 0;
+        in->size = 0;
+    }
+    return INBUF_SIZE - in->size;
+}
+
+int inbuf_fill(inbuf_t *in, int fd)
+{
+    size_t room = inbuf_reclaim(in);
+    int received = recv(fd, in->data + in->size, room, MSG_DONTWAIT);
+
+    if (received > 0) {
+        in->size += received;
+        return received;
+    }
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return -1;
+    }
+
+    // Connection closed or error
+    return 0;
+}
+
+// Bytes received elsewhere (io_uring buffers), as many as fit
+size_t inbuf_append(inbuf_t *in, const char *data, size_t len)
+{
+    size_t room = inbuf_reclaim(in);
+
+    if (len > room) len = room;
+    memcpy(in->data + in->size, data, len);
+    in->size += len;
+    return len;
+}
+
+char *inbuf_next_line(inbuf_t *in, size_t *len)
+{
+    char *base = in->data;
+
+    for (;;) {
+        // Only scan bytes that arrived since the last call
+        char *newline = memchr(base + in->scan, '\n',
+                               in->size - in->scan);
+        if (!newline) {
+            in->scan = in->size;
+            return NULL;
+        }
+
+        char *line = base + in->start;
+        char *end = newline;
+        in->start = newline - base + 1;
+        in->scan = in->start;
+
+        // Trim whitespace in place; the view stays valid until the next fill
+        while (line < end && isspace((unsigned char)*line)) line++;
+        while (end > line && isspace((unsigned char)end[-1])) end--;
+        *end = '\0';
+
+        if (end > line) {
+            *len = end - line;
+            return line;
+        }
+    }
+}
@@ -0,0 +1,502 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Network I/O threads implementation
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include "io_thread.h"
+#include "command.h"
+
+static void io_wake(int fd)
+{
+    eventfd_write(fd, 1);
+}
+
+static void io_conn_watch(io_thread_t *thread, io_conn_t *conn)
+{
+    uint32_t events = 0;
+
+    if (!conn->watched) return;
+    if (conn->reading) events |= EPOLLIN;
+    if (spsc_used(&conn->output) > 0) events |= EPOLLOUT;
+    if (events == conn->events) return;
+
+    struct epoll_event ev = {0};
+    ev.events = events;
+    ev.data.ptr = conn;
+    epoll_ctl(thread->epoll_fd, EPOLL_CTL_MOD, conn->fd, &ev);
+    conn->events = events;
+}
+
+// The socket is done: stop watching it and let the simulation know
+static void io_conn_shutdown(io_thread_t *thread, io_conn_t *conn)
+{
+    if (conn->watched) {
+        epoll_ctl(thread->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+        conn->watched = false;
+    }
+    conn->reading = false;
+    atomic_store_explicit(&conn->closed, true, memory_order_release);
+}
+
+// Complete lines go to the input ring while it has room for the
+// longest one. Returns true if anything was queued
+static bool io_conn_forward_lines(io_conn_t *conn)
+{
+    bool queued = false;
+    char *line;
+    size_t len;
+
+    for (;;) {
+        if (spsc_free_space(&conn->input) < IO_LINE_MAX) {
+            // Raise the flag before looking again, so a drain that
+            // happens in between cannot miss it
+            atomic_store(&conn->input_full, true);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (spsc_free_space(&conn->input) < IO_LINE_MAX) {
+                conn->reading = false;
+                return queued;
+            }
+            atomic_store(&conn->input_full, false);
+        }
+
+        line = inbuf_next_line(&conn->buffer, &len);
+        if (!line) return queued;
+
+        io_line_t header;
+        command_decode(line, len, &header.command);
+        header.length = len;
+        spsc_push(&conn->input, &header, sizeof(header), line, len);
+        queued = true;
+    }
+}
+
+// Reads until the socket is drained or the input ring is full.
+// Returns true if the simulation has something new
+static bool io_conn_read(io_thread_t *thread, io_conn_t *conn)
+{
+    bool notify = false;
+
+    conn->reading = true;
+    for (;;) {
+        notify |= io_conn_forward_lines(conn);
+        if (!conn->reading) break;
+
+        int received = inbuf_fill(&conn->buffer, conn->fd);
+        thread->syscalls++;
+        if (received < 0) break;
+        if (received == 0) {
+            io_conn_shutdown(thread, conn);
+            return true;
+        }
+    }
+    io_conn_watch(thread, conn);
+    return notify;
+}
+
+// Sends what the simulation queued. Returns true if the simulation was
+// waiting for room in the ring
+static bool io_conn_flush(io_thread_t *thread, io_conn_t *conn)
+{
+    struct iovec iov[2];
+    int count;
+    bool drained = false;
+
+    while ((count = spsc_peek(&conn->output, iov)) > 0) {
+        struct msghdr msg = {0};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        ssize_t sent = sendmsg(conn->fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        thread->syscalls++;
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            io_conn_shutdown(thread, conn);
+            return true;
+        }
+        spsc_consume(&conn->output, sent);
+        drained = true;
+    }
+    io_conn_watch(thread, conn);
+
+    if (!drained) return false;
+    atomic_thread_fence(memory_order_seq_cst);
+    return atomic_exchange(&conn->output_full, false);
+}
+
+static void io_thread_add(io_thread_t *thread, io_conn_t *conn)
+{
+    if (thread->conn_count >= thread->conn_capacity) {
+        int capacity = thread->conn_capacity ? thread->conn_capacity * 2 : 64;
+        io_conn_t **conns = realloc(thread->conns, capacity * sizeof(io_conn_t *));
+        if (!conns) {
+            io_conn_shutdown(thread, conn);
+            conn->slot = -1;
+            return;
+        }
+        thread->conns = conns;
+        thread->conn_capacity = capacity;
+    }
+
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.ptr = conn;
+    conn->slot = thread->conn_count;
+    thread->conns[thread->conn_count++] = conn;
+    conn->reading = true;
+    conn->events = EPOLLIN;
+    conn->watched = epoll_ctl(thread->epoll_fd, EPOLL_CTL_ADD, conn->fd, &ev) == 0;
+    if (!conn->watched) io_conn_shutdown(thread, conn);
+}
+
+static void io_conn_free(io_conn_t *conn)
+{
+    spsc_destroy(&conn->input);
+    spsc_destroy(&conn->output);
+    free(conn);
+}
+
+static void io_thread_remove(io_thread_t *thread, io_conn_t *conn)
+{
+    if (conn->watched) {
+        epoll_ctl(thread->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    }
+    close(conn->fd);
+
+    // Swap the last connection into the hole
+    if (conn->slot >= 0) {
+        thread->conn_count--;
+        if (conn->slot < thread->conn_count) {
+            thread->conns[conn->slot] = thread->conns[thread->conn_count];
+            thread->conns[conn->slot]->slot = conn->slot;
+        }
+    }
+    io_conn_free(conn);
+}
+
+// Connections handed over or given back by the simulation, then the
+// resumed reads and new output of the ones already here
+static bool io_thread_service(io_thread_t *thread)
+{
+    bool notify = false;
+
+    pthread_mutex_lock(&thread->lock);
+    io_conn_t *added = thread->added;
+    io_conn_t *removed = thread->removed;
+    thread->added = NULL;
+    thread->removed = NULL;
+    pthread_mutex_unlock(&thread->lock);
+
+    while (added) {
+        io_conn_t *next = added->next;
+        io_thread_add(thread, added);
+        notify |= atomic_load(&added->closed);
+        added = next;
+    }
+    while (removed) {
+        io_conn_t *next = removed->next;
+        io_thread_remove(thread, removed);
+        removed = next;
+    }
+
+    for (int i = 0; i < thread->conn_count; i++) {
+        io_conn_t *conn = thread->conns[i];
+        if (!conn->watched) continue;
+        if (!conn->reading && !atomic_load(&conn->input_full)) {
+            notify |= io_conn_read(thread, conn);
+        }
+        if (conn->watched && !(conn->events & EPOLLOUT) &&
+            spsc_used(&conn->output) > 0) {
+            notify |= io_conn_flush(thread, conn);
+        }
+    }
+    return notify;
+}
+
+static void *io_thread_run(void *arg)
+{
+    io_thread_t *thread = arg;
+    io_pool_t *pool = thread->pool;
+    struct epoll_event events[EVENT_BATCH];
+
+    while (atomic_load(&pool->running)) {
+        int count = epoll_wait(thread->epoll_fd, events, EVENT_BATCH, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        // Handoffs wait for the end of the batch: a connection given
+        // back must not be freed while later events still point at it
+        bool woken = false;
+        bool notify = false;
+        for (int i = 0; i < count; i++) {
+            io_conn_t *conn = events[i].data.ptr;
+            if (!conn) {
+                eventfd_t value;
+                eventfd_read(thread->wake_fd, &value);
+                woken = true;
+                continue;
+            }
+            if (!conn->watched) continue;
+            if (events[i].events & EPOLLOUT) {
+                notify |= io_conn_flush(thread, conn);
+            }
+            if (!conn->watched) continue;
+            if (events[i].events & EPOLLIN) {
+                notify |= io_conn_read(thread, conn);
+            } else if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                // Reset by the peer while input is full: what is left
+                // unread is dropped
+                io_conn_shutdown(thread, conn);
+                notify = true;
+            }
+        }
+        if (woken) notify |= io_thread_service(thread);
+        if (notify) io_wake(pool->wake_fd);
+    }
+    return NULL;
+}
+
+static bool io_thread_init(io_thread_t *thread, io_pool_t *pool)
+{
+    thread->pool = pool;
+    thread->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    thread->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    pthread_mutex_init(&thread->lock, NULL);
+    if (thread->wake_fd < 0 || thread->epoll_fd < 0) return false;
+
+    // The wake-up eventfd is the entry whose data.ptr is NULL
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    return epoll_ctl(thread->epoll_fd, EPOLL_CTL_ADD, thread->wake_fd, &ev) == 0;
+}
+
+io_pool_t *io_pool_create(int count)
+{
+    io_pool_t *pool = calloc(1, sizeof(io_pool_t));
+    if (!pool) return NULL;
+
+    pool->threads = calloc(count, sizeof(io_thread_t));
+    pool->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    atomic_init(&pool->running, true);
+    if (!pool->threads || pool->wake_fd < 0) {
+        io_pool_destroy(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        pool->threads[i].wake_fd = -1;
+        pool->threads[i].epoll_fd = -1;
+    }
+    pool->count = count;
+
+    // Signals stay with the simulation thread
+    sigset_t all;
+    sigset_t previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    for (int i = 0; i < count; i++) {
+        io_thread_t *thread = &pool->threads[i];
+        if (!io_thread_init(thread, pool) ||
+            pthread_create(&thread->thread, NULL, io_thread_run, thread) != 0) {
+            break;
+        }
+        pool->started++;
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (pool->started < count) {
+        io_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void io_pool_stop(io_pool_t *pool)
+{
+    if (!atomic_exchange(&pool->running, false)) return;
+
+    for (int i = 0; i < pool->started; i++) {
+        io_wake(pool->threads[i].wake_fd);
+    }
+    for (int i = 0; i < pool->started; i++) {
+        pthread_join(pool->threads[i].thread, NULL);
+    }
+}
+
+// Closes every connection, including those still used by clients
+void io_pool_destroy(io_pool_t *pool)
+{
+    if (!pool) return;
+
+    io_pool_stop(pool);
+    for (int i = 0; i < pool->count; i++) {
+        io_thread_t *thread = &pool->threads[i];
+
+        // Handed over but never picked up
+        for (io_conn_t *conn = thread->added; conn; ) {
+            io_conn_t *next = conn->next;
+            close(conn->fd);
+            io_conn_free(conn);
+            conn = next;
+        }
+        for (io_conn_t *conn = thread->removed; conn; ) {
+            io_conn_t *next = conn->next;
+            io_thread_remove(thread, conn);
+            conn = next;
+        }
+        while (thread->conn_count > 0) {
+            io_thread_remove(thread, thread->conns[thread->conn_count - 1]);
+        }
+
+        free(thread->conns);
+        if (thread->epoll_fd >= 0) close(thread->epoll_fd);
+        if (thread->wake_fd >= 0) close(thread->wake_fd);
+        pthread_mutex_destroy(&thread->lock);
+    }
+    if (pool->wake_fd >= 0) close(pool->wake_fd);
+    free(pool->threads);
+    free(pool);
+}
+
+// Sleeps until a tick is due, a listen socket is readable or an I/O
+// thread has news. Returns a mask of the listen sockets with a
+// connection waiting to be accepted
+int io_pool_wait(io_pool_t *pool, const int *listen_fds, int listen_count, int timeout)
+{
+    struct pollfd fds[1 + LISTEN_MAX] = {
+        { .fd = pool->wake_fd, .events = POLLIN },
+    };
+    for (int i = 0; i < listen_count; i++) {
+        fds[i + 1].fd = listen_fds[i];
+        fds[i + 1].events = POLLIN;
+    }
+
+    int ready = poll(fds, 1 + listen_count, timeout);
+    if (ready <= 0) return ready;
+
+    if (fds[0].revents & POLLIN) {
+        eventfd_t value;
+        eventfd_read(pool->wake_fd, &value);
+    }
+
+    int mask = 0;
+    for (int i = 0; i < listen_count; i++) {
+        if (fds[i + 1].revents & POLLIN) mask |= 1 << i;
+    }
+    return mask;
+}
+
+// One wake-up per thread that got output or handoffs this iteration
+void io_pool_wake(io_pool_t *pool)
+{
+    for (int i = 0; i < pool->count; i++) {
+        io_thread_t *thread = &pool->threads[i];
+        if (thread->signaled) {
+            thread->signaled = false;
+            io_wake(thread->wake_fd);
+        }
+    }
+}
+
+uint64_t io_pool_syscalls(io_pool_t *pool)
+{
+    uint64_t total = 0;
+
+    for (int i = 0; i < pool->count; i++) {
+        total += pool->threads[i].syscalls;
+    }
+    return total;
+}
+
+io_conn_t *io_pool_attach(io_pool_t *pool, int fd)
+{
+    io_conn_t *conn = calloc(1, sizeof(io_conn_t));
+    if (!conn) return NULL;
+
+    if (!spsc_init(&conn->input, IO_INPUT_RING) ||
+        !spsc_init(&conn->output, IO_OUTPUT_RING)) {
+        io_conn_free(conn);
+        return NULL;
+    }
+    conn->fd = fd;
+    conn->slot = -1;
+    atomic_init(&conn->closed, false);
+    atomic_init(&conn->input_full, false);
+    atomic_init(&conn->output_full, false);
+
+    io_thread_t *thread = &pool->threads[pool->next];
+    pool->next = (pool->next + 1) % pool->count;
+    conn->thread = thread;
+
+    pthread_mutex_lock(&thread->lock);
+    conn->next = thread->added;
+    thread->added = conn;
+    pthread_mutex_unlock(&thread->lock);
+    thread->signaled = true;
+    return conn;
+}
+
+// The simulation is done with the connection: its thread closes the
+// socket and frees it
+void io_conn_release(io_conn_t *conn)
+{
+    io_thread_t *thread = conn->thread;
+
+    pthread_mutex_lock(&thread->lock);
+    conn->next = thread->removed;
+    thread->removed = conn;
+    pthread_mutex_unlock(&thread->lock);
+    thread->signaled = true;
+}
+
+bool io_conn_closed(io_conn_t *conn)
+{
+    return atomic_load_explicit(&conn->closed, memory_order_acquire);
+}
+
+// Next decoded line, its text NUL-terminated in text (INBUF_SIZE + 1
+// bytes). Resumes reading once the ring has room again
+bool io_conn_next_line(io_conn_t *conn, io_line_t *header, char *text)
+{
+    if (spsc_used(&conn->input) == 0) {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_exchange(&conn->input_full, false)) {
+            conn->thread->signaled = true;
+        }
+        return false;
+    }
+
+    spsc_read(&conn->input, header, sizeof(io_line_t));
+    spsc_read(&conn->input, text, header->length);
+    text[header->length] = '\0';
+    return true;
+}
+
+// Queues as much as fits in the output ring
+size_t io_conn_send(io_conn_t *conn, const char *data, size_t len)
+{
+    size_t written = spsc_write(&conn->output, data, len);
+
+    if (written < len) {
+        // Ask for a wake-up once the thread makes room, then look again
+        atomic_store(&conn->output_full, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        written += spsc_write(&conn->output, data + written, len - written);
+    }
+    if (written > 0) conn->thread->signaled = true;
+    return written;
+}
@@ -25,13 +25,20 @@ static void signal_handler(int sig)
 static void print_usage(const char *prog)
 {
     printf("USAGE: %s -p port -x width -y height -n name1 name2 ... "
-           "-c clientsNb -f freq\n", prog);
+           "-c clientsNb -f freq [-e backend] [-w bytes] [-t threads] "
+           "[-u path] [-b backlog]\n", prog);
     printf("\tport\t\tis the port number\n");
     printf("\twidth\t\tis the width of the world\n");
     printf("\theight\t\tis the height of the world\n");
     printf("\tnameX\t\tis the name of the team X\n");
     printf("\tclientsNb\tis the number of authorized clients per team\n");
     printf("\tfreq\t\tis the reciprocal of time unit for execution of actions\n");
+    printf("\tbackend\t\tis the event loop backend: poll (default), epoll or uring\n");
+    printf("\tbytes\t\tis the per-client output high-water mark (default 1 MiB)\n");
+    printf("\tthreads\t\tis the number of network I/O threads (default 0: none),\n"
+           "\t\t\tnot available with the uring backend\n");
+    printf("\tpath\t\tis a Unix socket to accept local clients on, besides the port\n");
+    printf("\tbacklog\t\tis the listen queue length (default 1024)\n");
 }
 
 int main(int argc, char **argv)
@@ -9,6 +9,112 @@
 #include <string.h>
 #include <stdio.h>
 #include "map.h"
+#include "msg.h"
+#include "utils.h"
+
+#define OVERFLOW_CLASSES 16
+#define OVERFLOW_POOL_MAX 64
+
+// Look words, each with its leading separator
+static const char *const look_words[RESOURCE_COUNT + 1] = {
+    " food", " linemate", " deraumere", " sibur",
+    " mendiane", " phiras", " thystame", " player"
+};
+static const size_t look_word_size[RESOURCE_COUNT + 1] = {5, 9, 10, 6, 9, 7, 9, 7};
+
+// Recycled overflow arrays, one free list per power-of-two capacity
+typedef struct overflow_block_s {
+    struct overflow_block_s *next;
+} overflow_block_t;
+
+static overflow_block_t *overflow_pool[OVERFLOW_CLASSES];
+static int overflow_pool_count[OVERFLOW_CLASSES];
+
+static int overflow_class(uint32_t capacity)
+{
+    int class = 0;
+    while (((uint32_t)TILE_INLINE_IDS * 2 << class) < capacity) class++;
+    return class;
+}
+
+static int *overflow_alloc(uint32_t capacity)
+{
+    int class = overflow_class(capacity);
+    overflow_block_t *block = class < OVERFLOW_CLASSES ? overflow_pool[class] : NULL;
+
+    if (block) {
+        overflow_pool[class] = block->next;
+        overflow_pool_count[class]--;
+        return (int *)block;
+    }
+    return malloc(capacity * sizeof(int));
+}
+
+static void overflow_free(int *ids, uint32_t capacity)
+{
+    int class = overflow_class(capacity);
+
+    if (class >= OVERFLOW_CLASSES || overflow_pool_count[class] >= OVERFLOW_POOL_MAX) {
+        free(ids);
+        return;
+    }
+    overflow_block_t *block = (overflow_block_t *)ids;
+    block->next = overflow_pool[class];
+    overflow_pool[class] = block;
+    overflow_pool_count[class]++;
+}
+
+static void tile_ids_add(tile_ids_t *list, int id)
+{
+    uint32_t limit = list->capacity ? list->capacity : TILE_INLINE_IDS;
+
+    // Spill to the next overflow size; a player or egg missing from its
+    // tile would skew Look, eject and incantation, so running out is fatal
+    if (list->count == limit) {
+        int *ids = overflow_alloc(limit * 2);
+        if (!ids) die("Out of memory growing a tile to %u ids", limit * 2);
+        memcpy(ids, tile_ids(list), list->count * sizeof(int));
+        if (list->capacity) overflow_free(list->ids, list->capacity);
+        list->ids = ids;
+        list->capacity = limit * 2;
+    }
+
+    tile_ids(list)[list->count++] = id;
+}
+
+static void tile_ids_remove(tile_ids_t *list, int id)
+{
+    int *ids = tile_ids(list);
+
+    // From the end, so clearing a tile last id first stays linear
+    for (uint32_t i = list->count; i-- > 0;) {
+        if (ids[i] != id) continue;
+
+        // Order does not matter: swap the last id in
+        ids[i] = ids[--list->count];
+
+        // Back inline once it fits again
+        if (list->capacity && list->count <= TILE_INLINE_IDS) {
+            int *overflow = list->ids;
+            memcpy(list->inline_ids, overflow, list->count * sizeof(int));
+            overflow_free(overflow, list->capacity);
+            list->capacity = 0;
+        }
+        return;
+    }
+}
+
+static void tile_ids_clear(tile_ids_t *list)
+{
+    if (list->capacity) overflow_free(list->ids, list->capacity);
+    list->capacity = 0;
+    list->count = 0;
+}
+
+static void tile_invalidate(tile_t *tile, uint8_t parts)
+{
+    if (tile->text) tile->text->valid &= ~parts;
+}
 
 map_t *map_create(int width, int height)
 {
@@ -16,7 +122,8 @@ map_t *map_create(int width, int height)
     fflush(stdout);
     
     // Validate parameters
-    if (width <= 0 || height <= 0 || width > 1000 || height > 1000) {
+    if (width <= 0 || height <= 0 ||
+        (size_t)width * height > SIZE_MAX / sizeof(tile_t)) {
         printf("ERROR: Invalid map dimensions: %dx%d\n", width, height);
         return NULL;
     }
@@ -30,56 +137,14 @@ map_t *map_create(int width, int height)
     map->width = width;
     map->height = height;
     
-    printf("DEBUG: Allocating tiles array for %d rows\n", height);
-    fflush(stdout);
-    
-    // Allocate tiles
-    map->tiles = calloc(height, sizeof(tile_t *));
+    // One contiguous block, row after row; calloc leaves every tile empty
+    map->tiles = calloc((size_t)width * height, sizeof(tile_t));
     if (!map->tiles) {
         printf("ERROR: Failed to allocate tiles array\n");
         free(map);
         return NULL;
     }
     
-    printf("DEBUG: Allocating individual tile rows\n");
-    fflush(stdout);
-    
-    for (int y = 0; y < height; y++) {
-        map->tiles[y] = calloc(width, sizeof(tile_t));
-        if (!map->tiles[y]) {
-            printf("ERROR: Failed to allocate tile row %d\n", y);
-            // Cleanup already allocated rows
-            for (int i = 0; i < y; i++) {
-                if (map->tiles[i]) {
-                    for (int x = 0; x < width; x++) {
-                        tile_t *tile = &map->tiles[i][x];
-                        if (tile->players) free(tile->players);
-                        if (tile->eggs) free(tile->eggs);
-                    }
-                    free(map->tiles[i]);
-                }
-            }
-            free(map->tiles);
-            free(map);
-            return NULL;
-        }
-        
-        // Initialize tiles in this row
-        for (int x = 0; x < width; x++) {
-            tile_t *tile = &map->tiles[y][x];
-            // Initialize all resources to 0 (calloc already does this)
-            tile->players = NULL;
-            tile->player_count = 0;
-            tile->eggs = NULL;
-            tile->egg_count = 0;
-        }
-        
-        if ((y + 1) % 100 == 0) {
-            printf("DEBUG: Allocated %d/%d rows\n", y + 1, height);
-            fflush(stdout);
-        }
-    }
-    
     printf("DEBUG: Map creation completed successfully\n");
     fflush(stdout);
     return map;
@@ -90,15 +155,11 @@ void map_destroy(map_t *map)
     if (!map) return;
     
     if (map->tiles) {
-        for (int y = 0; y < map->height; y++) {
-            if (map->tiles[y]) {
-                for (int x = 0; x < map->width; x++) {
-                    tile_t *tile = &map->tiles[y][x];
-                    if (tile->players) free(tile->players);
-                    if (tile->eggs) free(tile->eggs);
-                }
-                free(map->tiles[y]);
-            }
+        size_t count = (size_t)map->width * map->height;
+        for (size_t i = 0; i < count; i++) {
+            tile_ids_clear(&map->tiles[i].players);
+            tile_ids_clear(&map->tiles[i].eggs);
+            free(map->tiles[i].text);
         }
         free(map->tiles);
     }
@@ -111,7 +172,7 @@ tile_t *map_get_tile(map_t *map, int x, int y)
     if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
         return NULL;
     }
-    return &map->tiles[y][x];
+    return &map->tiles[(size_t)y * map->width + x];
 }
 
 void map_add_player(map_t *map, int x, int y, int player_id)
@@ -119,8 +180,8 @@ void map_add_player(map_t *map, int x, int y, int player_id)
     tile_t *tile = map_get_tile(map, x, y);
     if (!tile) return;
     
-    tile->players = realloc(tile->players, (tile->player_count + 1) * sizeof(int));
-    tile->players[tile->player_count++] = player_id;
+    tile_ids_add(&tile->players, player_id);
+    tile_invalidate(tile, TILE_TEXT_LOOK);
 }
 
 void map_remove_player(map_t *map, int x, int y, int player_id)
@@ -128,23 +189,8 @@ void map_remove_player(map_t *map, int x, int y, int player_id)
     tile_t *tile = map_get_tile(map, x, y);
     if (!tile) return;
     
-    // Find and remove player
-    for (int i = 0; i < tile->player_count; i++) {
-        if (tile->players[i] == player_id) {
-            // Shift remaining players
-            for (int j = i; j < tile->player_count - 1; j++) {
-                tile->players[j] = tile->players[j + 1];
-            }
-            tile->player_count--;
-            
-            // Resize array
-            if (tile->player_count == 0) {
-                free(tile->players);
-                tile->players = NULL;
-            }
-            break;
-        }
-    }
+    tile_ids_remove(&tile->players, player_id);
+    tile_invalidate(tile, TILE_TEXT_LOOK);
 }
 
 void map_add_egg(map_t *map, int x, int y, int egg_id)
@@ -152,8 +198,7 @@ void map_add_egg(map_t *map, int x, int y, int egg_id)
     tile_t *tile = map_get_tile(map, x, y);
     if (!tile) return;
     
-    tile->eggs = realloc(tile->eggs, (tile->egg_count + 1) * sizeof(int));
-    tile->eggs[tile->egg_count++] = egg_id;
+    tile_ids_add(&tile->eggs, egg_id);
 }
 
 void map_remove_egg(map_t *map, int x, int y, int egg_id)
@@ -161,23 +206,108 @@ void map_remove_egg(map_t *map, int x, int y, int egg_id)
     tile_t *tile = map_get_tile(map, x, y);
     if (!tile) return;
     
-    // Find and remove egg
-    for (int i = 0; i < tile->egg_count; i++) {
-        if (tile->eggs[i] == egg_id) {
-            // Shift remaining eggs
-            for (int j = i; j < tile->egg_count - 1; j++) {
-                tile->eggs[j] = tile->eggs[j + 1];
-            }
-            tile->egg_count--;
-            
-            // Resize array
-            if (tile->egg_count == 0) {
-                free(tile->eggs);
-                tile->eggs = NULL;
-            }
-            break;
+    tile_ids_remove(&tile->eggs, egg_id);
+}
+
+// All resource changes go through these two, keeping map->totals exact
+void map_add_resource(map_t *map, tile_t *tile, int resource, int amount)
+{
+    // Removal goes through map_remove_resource, which stops at 0
+    if (amount <= 0) return;
+
+    // Counts are 16-bit: saturate rather than wrap
+    int total = tile->resources[resource] + amount;
+    if (total > TILE_RESOURCE_MAX) total = TILE_RESOURCE_MAX;
+
+    map->totals[resource] += total - tile->resources[resource];
+    tile->resources[resource] = total;
+    tile_invalidate(tile, TILE_TEXT_LOOK | TILE_TEXT_BCT);
+}
+
+void map_remove_resource(map_t *map, tile_t *tile, int resource, int amount)
+{
+    if (amount > tile->resources[resource]) amount = tile->resources[resource];
+
+    map->totals[resource] -= amount;
+    tile->resources[resource] -= amount;
+    tile_invalidate(tile, TILE_TEXT_LOOK | TILE_TEXT_BCT);
+}
+
+static tile_text_t *tile_text_reserve(tile_t *tile, size_t look_size)
+{
+    tile_text_t *text = tile->text;
+
+    if (text && text->look_capacity >= look_size) return text;
+
+    size_t capacity = text && text->look_capacity * 2 > look_size ?
+        text->look_capacity * 2 : look_size;
+    if (capacity < 64) capacity = 64;
+    text = realloc(text, sizeof(tile_text_t) + capacity);
+    if (!text) return NULL;
+    if (!tile->text) text->valid = 0;
+    text->look_capacity = capacity;
+    tile->text = text;
+    return text;
+}
+
+// Words for a Look reply, each preceded by a space; len 0 if empty
+const char *tile_look_text(tile_t *tile, size_t *len)
+{
+    if (tile->text && (tile->text->valid & TILE_TEXT_LOOK)) {
+        *len = tile->text->look_size;
+        return tile->text->look;
+    }
+
+    size_t size = tile->players.count * look_word_size[RESOURCE_COUNT];
+    for (int res = 0; res < RESOURCE_COUNT; res++) {
+        size += tile->resources[res] * look_word_size[res];
+    }
+
+    tile_text_t *text = tile_text_reserve(tile, size);
+    if (!text) return NULL;
+
+    char *dst = text->look;
+    for (uint32_t i = 0; i < tile->players.count; i++) {
+        memcpy(dst, look_words[RESOURCE_COUNT], look_word_size[RESOURCE_COUNT]);
+        dst += look_word_size[RESOURCE_COUNT];
+    }
+    for (int res = 0; res < RESOURCE_COUNT; res++) {
+        for (int count = 0; count < tile->resources[res]; count++) {
+            memcpy(dst, look_words[res], look_word_size[res]);
+            dst += look_word_size[res];
         }
     }
+    text->look_size = size;
+    text->valid |= TILE_TEXT_LOOK;
+
+    *len = size;
+    return text->look;
+}
+
+// Resource counts ending a bct line, newline included. Counts are at
+// most TILE_RESOURCE_MAX, so the line fits in TILE_BCT_MAX
+size_t tile_format_bct(tile_t *tile, char *buffer)
+{
+    char *p = buffer;
+
+    for (int res = 0; res < RESOURCE_COUNT; res++) {
+        p = msg_format_int(p, tile->resources[res]);
+        *p++ = res < RESOURCE_COUNT - 1 ? ' ' : '\n';
+    }
+    return p - buffer;
+}
+
+const char *tile_bct_text(tile_t *tile, size_t *len)
+{
+    if (!tile->text || !(tile->text->valid & TILE_TEXT_BCT)) {
+        tile_text_t *text = tile_text_reserve(tile, 0);
+        if (!text) return NULL;
+        text->bct_size = tile_format_bct(tile, text->bct);
+        text->valid |= TILE_TEXT_BCT;
+    }
+
+    *len = tile->text->bct_size;
+    return tile->text->bct;
 }
 
 int map_wrap_x(map_t *map, int x)
@@ -192,4 +322,4 @@ int map_wrap_y(map_t *map, int y)
     y = y % map->height;
     if (y < 0) y += map->height;
     return y;
-}
\ No newline at end of file
+}
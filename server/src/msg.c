@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Protocol line builder implementation
+*/
+
+#include <string.h>
+#include "msg.h"
+
+// "00" to "99", two digits written per division
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint32_t powers_of_10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000,
+    10000000, 100000000, 1000000000
+};
+
+// Digit count without a loop: the bit width times log10(2) (about
+// 1233 / 4096) undershoots by at most one, which a compare fixes.
+// value | 1 has the same digit count and keeps clz defined for 0
+static int msg_digits(uint32_t value)
+{
+    uint32_t v = value | 1;
+    int estimate = ((32 - __builtin_clz(v)) * 1233) >> 12;
+
+    return estimate + 1 - (v < powers_of_10[estimate]);
+}
+
+char *msg_format_uint(char *dst, uint32_t value)
+{
+    char *end = dst + msg_digits(value);
+    char *p = end;
+
+    while (value >= 100) {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        memcpy(p, digit_pairs + pair, 2);
+    }
+    if (value >= 10) {
+        memcpy(p - 2, digit_pairs + value * 2, 2);
+    } else {
+        p[-1] = '0' + value;
+    }
+    return end;
+}
+
+char *msg_format_int(char *dst, int value)
+{
+    // The sign is always written and kept only for negative values
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+
+    *dst = '-';
+    return msg_format_uint(dst + (value < 0), magnitude);
+}
@@ -0,0 +1,179 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Output queue implementation
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/uio.h>
+#include "outbuf.h"
+
+#define OUTBUF_POOL_MAX 256
+
+// Recycled chunks, so steady traffic does not hit malloc
+static out_chunk_t *chunk_pool = NULL;
+static int chunk_pool_count = 0;
+
+static out_chunk_t *chunk_alloc(void)
+{
+    out_chunk_t *chunk = chunk_pool;
+
+    if (chunk) {
+        chunk_pool = chunk->next;
+        chunk_pool_count--;
+    } else {
+        chunk = malloc(sizeof(out_chunk_t));
+        if (!chunk) return NULL;
+    }
+
+    chunk->next = NULL;
+    chunk->start = 0;
+    chunk->end = 0;
+    return chunk;
+}
+
+static void chunk_free(out_chunk_t *chunk)
+{
+    if (chunk_pool_count >= OUTBUF_POOL_MAX) {
+        free(chunk);
+        return;
+    }
+    chunk->next = chunk_pool;
+    chunk_pool = chunk;
+    chunk_pool_count++;
+}
+
+bool outbuf_append(outbuf_t *ob, const char *data, size_t len)
+{
+    while (len > 0) {
+        out_chunk_t *tail = ob->tail;
+
+        // Start a new chunk when the tail is full
+        if (!tail || tail->end == OUTBUF_CHUNK_SIZE) {
+            out_chunk_t *chunk = chunk_alloc();
+            if (!chunk) return false;
+            if (tail) {
+                tail->next = chunk;
+            } else {
+                ob->head = chunk;
+            }
+            ob->tail = chunk;
+            tail = chunk;
+        }
+
+        size_t room = OUTBUF_CHUNK_SIZE - tail->end;
+        size_t n = len < room ? len : room;
+        memcpy(tail->data + tail->end, data, n);
+        tail->end += n;
+        ob->size += n;
+        data += n;
+        len -= n;
+    }
+
+    return true;
+}
+
+// Contiguous room for len bytes (at most OUTBUF_CHUNK_SIZE) at the
+// tail, to be written in place and then passed to outbuf_commit
+char *outbuf_reserve(outbuf_t *ob, size_t len)
+{
+    out_chunk_t *tail = ob->tail;
+
+    if (!tail || OUTBUF_CHUNK_SIZE - tail->end < len) {
+        out_chunk_t *chunk = chunk_alloc();
+        if (!chunk) return NULL;
+        if (tail) {
+            tail->next = chunk;
+        } else {
+            ob->head = chunk;
+        }
+        ob->tail = chunk;
+        tail = chunk;
+    }
+    return tail->data + tail->end;
+}
+
+void outbuf_commit(outbuf_t *ob, size_t len)
+{
+    ob->tail->end += len;
+    ob->size += len;
+}
+
+// Contiguous pending bytes at the head
+size_t outbuf_peek(outbuf_t *ob, const char **data)
+{
+    out_chunk_t *head = ob->head;
+
+    // Skip a head left empty by an unused reservation
+    while (head && head->start == head->end && head->next) {
+        ob->head = head->next;
+        chunk_free(head);
+        head = ob->head;
+    }
+    if (!head) return 0;
+    *data = head->data + head->start;
+    return head->end - head->start;
+}
+
+void outbuf_consume(outbuf_t *ob, size_t len)
+{
+    ob->size -= len;
+
+    while (len > 0 && ob->head) {
+        out_chunk_t *head = ob->head;
+        size_t avail = head->end - head->start;
+
+        if (len < avail) {
+            head->start += len;
+            return;
+        }
+
+        len -= avail;
+        ob->head = head->next;
+        if (!ob->head) ob->tail = NULL;
+        chunk_free(head);
+    }
+}
+
+ssize_t outbuf_flush(outbuf_t *ob, int fd, uint64_t *syscalls)
+{
+    ssize_t total = 0;
+
+    while (ob->size > 0) {
+        struct iovec iov[OUTBUF_MAX_IOV];
+        int count = 0;
+
+        for (out_chunk_t *c = ob->head; c && count < OUTBUF_MAX_IOV; c = c->next) {
+            iov[count].iov_base = c->data + c->start;
+            iov[count].iov_len = c->end - c->start;
+            count++;
+        }
+
+        ssize_t sent = writev(fd, iov, count);
+        (*syscalls)++;
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+
+        outbuf_consume(ob, sent);
+        total += sent;
+    }
+
+    return total;
+}
+
+void outbuf_clear(outbuf_t *ob)
+{
+    while (ob->head) {
+        out_chunk_t *next = ob->head->next;
+        chunk_free(ob->head);
+        ob->head = next;
+    }
+    ob->tail = NULL;
+    ob->size = 0;
+}
@@ -22,10 +22,7 @@ player_t *player_create(int id, int client_id, int team_id, int x, int y)
     player->y = y;
     player->orientation = (rand() % 4) + 1;  // Random orientation
     player->level = 1;
-    player->life_units = 1260;  // 10 food * 126 units
-    
-    // Start with 10 food
-    player->inventory[RES_FOOD] = 10;
+    player->starve_index = -1;
 
     return player;
 }
@@ -63,21 +60,3 @@ void player_turn_left(player_t *player)
 {
     player->orientation = ((player->orientation - 2 + 4) % 4) + 1;
 }
-
-void player_consume_life(player_t *player)
-{
-    player->life_units--;
-    
-    // Consume food when life runs out
-    if (player->life_units <= 0 && player->inventory[RES_FOOD] > 0) {
-        player->inventory[RES_FOOD]--;
-        player->life_units += 126;
-    } else if (player->life_units <= 0) {
-        player->is_dead = true;
-    }
-}
-
-bool player_is_alive(player_t *player)
-{
-    return !player->is_dead;
-}
\ No newline at end of file
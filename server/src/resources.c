@@ -38,6 +38,16 @@ int resource_from_name(const char *name)
     return -1;
 }
 
+int resource_from_slice(const char *name, size_t len)
+{
+    for (int i = 0; i < RESOURCE_COUNT; i++) {
+        if (strlen(RESOURCE_NAMES[i]) == len && memcmp(name, RESOURCE_NAMES[i], len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 const char *resource_to_name(resource_t resource)
 {
     if (resource >= 0 && resource < RESOURCE_COUNT) {
@@ -0,0 +1,142 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Scheduler implementation
+*/
+
+#include <stdlib.h>
+#include "scheduler.h"
+
+scheduler_t *scheduler_create(void)
+{
+    scheduler_t *sched = calloc(1, sizeof(scheduler_t));
+    if (!sched) return NULL;
+
+    sched->capacity = 64;
+    sched->heap = calloc(sched->capacity, sizeof(sched_entry_t));
+    if (!sched->heap) {
+        free(sched);
+        return NULL;
+    }
+
+    return sched;
+}
+
+void scheduler_destroy(scheduler_t *sched)
+{
+    if (!sched) return;
+
+    // Detach remaining owners
+    for (int i = 0; i < sched->count; i++) {
+        *sched->heap[i].index = -1;
+    }
+
+    free(sched->heap);
+    free(sched);
+}
+
+static void heap_set(scheduler_t *sched, int i, sched_entry_t entry)
+{
+    sched->heap[i] = entry;
+    *entry.index = i;
+}
+
+static void heap_sift_up(scheduler_t *sched, int i)
+{
+    sched_entry_t entry = sched->heap[i];
+
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (sched->heap[parent].deadline <= entry.deadline) break;
+        heap_set(sched, i, sched->heap[parent]);
+        i = parent;
+    }
+    heap_set(sched, i, entry);
+}
+
+static void heap_sift_down(scheduler_t *sched, int i)
+{
+    sched_entry_t entry = sched->heap[i];
+
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= sched->count) break;
+        if (child + 1 < sched->count &&
+            sched->heap[child + 1].deadline < sched->heap[child].deadline) {
+            child++;
+        }
+        if (entry.deadline <= sched->heap[child].deadline) break;
+        heap_set(sched, i, sched->heap[child]);
+        i = child;
+    }
+    heap_set(sched, i, entry);
+}
+
+bool scheduler_push(scheduler_t *sched, uint64_t deadline, void *data, int *index)
+{
+    // Already scheduled: move the existing entry
+    if (*index >= 0) {
+        scheduler_remove(sched, index);
+    }
+
+    if (sched->count >= sched->capacity) {
+        int capacity = sched->capacity * 2;
+        sched_entry_t *heap = realloc(sched->heap, capacity * sizeof(sched_entry_t));
+        if (!heap) return false;
+        sched->heap = heap;
+        sched->capacity = capacity;
+    }
+
+    sched_entry_t entry = {deadline, data, index};
+    sched->heap[sched->count] = entry;
+    *index = sched->count;
+    sched->count++;
+    heap_sift_up(sched, sched->count - 1);
+
+    return true;
+}
+
+void scheduler_remove(scheduler_t *sched, int *index)
+{
+    int i = *index;
+    if (i < 0 || i >= sched->count) return;
+
+    *index = -1;
+    sched->count--;
+    if (i == sched->count) return;
+
+    // Move the last entry into the hole and restore the heap order
+    heap_set(sched, i, sched->heap[sched->count]);
+    if (i > 0 && sched->heap[(i - 1) / 2].deadline > sched->heap[i].deadline) {
+        heap_sift_up(sched, i);
+    } else {
+        heap_sift_down(sched, i);
+    }
+}
+
+// Move an entry to a new deadline in place
+void scheduler_update(scheduler_t *sched, int *index, uint64_t deadline)
+{
+    int i = *index;
+    if (i < 0 || i >= sched->count) return;
+
+    uint64_t previous = sched->heap[i].deadline;
+    sched->heap[i].deadline = deadline;
+    if (deadline < previous) {
+        heap_sift_up(sched, i);
+    } else {
+        heap_sift_down(sched, i);
+    }
+}
+
+void *scheduler_pop_due(scheduler_t *sched, uint64_t now)
+{
+    if (sched->count == 0 || sched->heap[0].deadline > now) {
+        return NULL;
+    }
+
+    void *data = sched->heap[0].data;
+    scheduler_remove(sched, sched->heap[0].index);
+    return data;
+}
@@ -5,6 +5,7 @@
 ** Server implementation
 */
 
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,8 +16,12 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/un.h>
+#include <sys/stat.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include "server.h"
 #include "game.h"
 #include "network.h"
@@ -25,6 +30,10 @@
 #include "utils.h"
 #include "command.h"
 #include "gui_protocol.h"
+#include "event.h"
+#include "scheduler.h"
+#include "io_thread.h"
+#include "uring.h"
 
 static config_t *parse_arguments(int argc, char **argv)
 {
@@ -36,8 +45,10 @@ static config_t *parse_arguments(int argc, char **argv)
     int name_count = 0;
     int name_capacity = 0;
     config->freq = 100;  // Default frequency
+    config->output_hwm = OUTPUT_HWM_DEFAULT;
+    config->listen_backlog = LISTEN_BACKLOG_DEFAULT;
 
-    while ((opt = getopt(argc, argv, "p:x:y:n:c:f:")) != -1) {
+    while ((opt = getopt(argc, argv, "p:x:y:n:c:f:e:w:t:u:b:")) != -1) {
         switch (opt) {
             case 'p': 
                 config->port = atoi(optarg); 
@@ -97,6 +108,26 @@ static config_t *parse_arguments(int argc, char **argv)
             case 'f': 
                 config->freq = atoi(optarg); 
                 break;
+            case 'w': 
+                config->output_hwm = strtoul(optarg, NULL, 10); 
+                break;
+            case 't': 
+                config->io_threads = atoi(optarg); 
+                break;
+            case 'u': 
+                config->unix_path = optarg; 
+                break;
+            case 'b': 
+                config->listen_backlog = atoi(optarg); 
+                break;
+            case 'e': {
+                int backend = event_backend_from_name(optarg);
+                if (backend >= 0) {
+                    config->backend = backend;
+                    break;
+                }
+            }
+            /* fall through */
             default:
                 // Cleanup on error
                 if (names) {
@@ -112,8 +143,18 @@ static config_t *parse_arguments(int argc, char **argv)
 
     // Validate required parameters
     if (!config->port || !config->width || !config->height || 
-        !config->clients_nb || !config->team_names || config->team_count == 0) {
-        
+        !config->clients_nb || !config->team_names || config->team_count == 0 ||
+        config->freq <= 0 || !config->output_hwm || config->listen_backlog <= 0 ||
+        config->io_threads < 0 ||
+        config->io_threads > IO_THREADS_MAX ||
+        (config->io_threads > 0 && config->backend == BACKEND_URING)) {
+        // The only combination of valid values that is still refused
+        if (config->io_threads > 0 && config->io_threads <= IO_THREADS_MAX &&
+            config->backend == BACKEND_URING) {
+            printf("ERROR: -t cannot be combined with -e uring\n");
+            log_error("I/O threads are not supported with the uring backend");
+        }
+
         // Cleanup on validation failure
         if (config->team_names) {
             for (int i = 0; i < config->team_count; i++) {
@@ -128,21 +169,17 @@ static config_t *parse_arguments(int argc, char **argv)
     return config;
 }
 
-static network_t *network_create(uint16_t port)
+// Listen sockets are non-blocking so that accepting can drain the
+// queue until EAGAIN; io_uring arms its own accepts and keeps them
+// blocking
+static int network_listen_tcp(uint16_t port, int backlog, int flags)
 {
-    network_t *net = calloc(1, sizeof(network_t));
-    if (!net) return NULL;
-
-    // Create listen socket
-    net->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (net->listen_fd < 0) {
-        free(net);
-        return NULL;
-    }
+    int fd = socket(AF_INET, SOCK_STREAM | flags, 0);
+    if (fd < 0) return -1;
 
     // Allow reuse
     int opt = 1;
-    setsockopt(net->listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 
     // Bind
     struct sockaddr_in addr = {0};
@@ -150,29 +187,105 @@ static network_t *network_create(uint16_t port)
     addr.sin_addr.s_addr = INADDR_ANY;
     addr.sin_port = htons(port);
 
-    if (bind(net->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
-        close(net->listen_fd);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, backlog) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Stream socket at path for clients on the same host, which skip the
+// loopback TCP stack. A socket left by a previous run is replaced
+static int network_listen_unix(const char *path, int backlog, int flags)
+{
+    struct sockaddr_un addr = {0};
+    struct stat st;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | flags, 0);
+    if (fd < 0) return -1;
+
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, backlog) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void network_close_listeners(network_t *net)
+{
+    for (int i = 0; i < net->listen_count; i++) {
+        close(net->listen_fds[i]);
+    }
+    if (net->unix_path) unlink(net->unix_path);
+    if (net->spare_fd >= 0) close(net->spare_fd);
+}
+
+static network_t *network_create(config_t *config)
+{
+    network_t *net = calloc(1, sizeof(network_t));
+    if (!net) return NULL;
+
+    net->output_hwm = config->output_hwm;
+    net->output_limit = config->output_hwm * OUTPUT_LIMIT_FACTOR;
+
+    // Every team slot filled at match start, plus a few GUIs, fits
+    // without growing the client and poll arrays
+    net->client_capacity = config->clients_nb * config->team_count + CLIENT_SLACK;
+
+    // Create listen sockets: TCP, plus Unix when a path is given
+    int flags = SOCK_CLOEXEC;
+    if (config->backend != BACKEND_URING) flags |= SOCK_NONBLOCK;
+    net->spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    net->listen_fds[0] = network_listen_tcp(config->port, config->listen_backlog, flags);
+    if (net->listen_fds[0] < 0) {
+        if (net->spare_fd >= 0) close(net->spare_fd);
         free(net);
         return NULL;
     }
+    net->listen_count = 1;
+    if (config->unix_path) {
+        int fd = network_listen_unix(config->unix_path, config->listen_backlog, flags);
+        if (fd < 0) {
+            network_close_listeners(net);
+            free(net);
+            return NULL;
+        }
+        net->listen_fds[net->listen_count++] = fd;
+        net->unix_path = config->unix_path;
+    }
 
-    // Listen
-    if (listen(net->listen_fd, 128) < 0) {
-        close(net->listen_fd);
+    // Initialize event backend
+    if (event_init(net, config->backend) < 0) {
+        network_close_listeners(net);
         free(net);
         return NULL;
     }
 
-    // Initialize poll
-    net->poll_capacity = 16;
-    net->poll_fds = calloc(net->poll_capacity, sizeof(struct pollfd));
-    net->poll_fds[0].fd = net->listen_fd;
-    net->poll_fds[0].events = POLLIN;
-    net->poll_count = 1;
+    // Sockets go to I/O threads when asked for
+    if (config->io_threads > 0) {
+        net->io = io_pool_create(config->io_threads);
+        if (!net->io) {
+            event_destroy(net);
+            network_close_listeners(net);
+            free(net);
+            return NULL;
+        }
+    }
 
     // Initialize clients
-    net->client_capacity = 16;
     net->clients = calloc(net->client_capacity, sizeof(client_t *));
+    if (!net->clients) {
+        io_pool_destroy(net->io);
+        event_destroy(net);
+        network_close_listeners(net);
+        free(net);
+        return NULL;
+    }
 
     return net;
 }
@@ -181,31 +294,54 @@ static void network_destroy(network_t *net)
 {
     if (!net) return;
 
+    // Stop the I/O threads, closing the sockets they own
+    io_pool_destroy(net->io);
+
+    // Tear down the backend first: io_uring closes its sockets and must
+    // not send from output freed below
+    event_destroy(net);
+
     // Close all clients
     for (int i = 0; i < net->client_count; i++) {
         if (net->clients[i]) {
-            close(net->clients[i]->fd);
+            if (!net->clients[i]->conn && !net->clients[i]->uring_conn) {
+                close(net->clients[i]->fd);
+            }
             client_destroy(net->clients[i]);
         }
     }
 
-    // Close listen socket
-    close(net->listen_fd);
+    // Close listen sockets
+    network_close_listeners(net);
 
     // Free memory
-    free(net->poll_fds);
     free(net->clients);
+    free(net->dirty);
     free(net);
 }
 
-static client_t *network_accept_client(server_t *server)
+// Registers an accepted socket as a new client. The socket comes
+// non-blocking and close-on-exec from accept4 or io_uring
+client_t *network_add_client(server_t *server, int fd)
 {
     network_t *net = server->network;
-    struct sockaddr_in addr;
-    socklen_t addr_len = sizeof(addr);
 
-    int fd = accept(net->listen_fd, (struct sockaddr *)&addr, &addr_len);
-    if (fd < 0) return NULL;
+    // Expand arrays if needed: only past the preallocated team slots
+    if (net->client_count >= net->client_capacity) {
+        int capacity = net->client_capacity * 2;
+        client_t **clients = realloc(net->clients, capacity * sizeof(client_t *));
+        if (!clients) {
+            close(fd);
+            return NULL;
+        }
+        net->clients = clients;
+        net->client_capacity = capacity;
+    }
+
+    // Replies are single short lines: send them without Nagle's delay.
+    // Fails harmlessly on the Unix socket
+    int nodelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
 
     // Create client
     client_t *client = client_create(fd);
@@ -214,43 +350,72 @@ static client_t *network_accept_client(server_t *server)
         return NULL;
     }
 
-    // Expand arrays if needed
-    if (net->client_count >= net->client_capacity) {
-        net->client_capacity *= 2;
-        net->clients = realloc(net->clients, net->client_capacity * sizeof(client_t *));
+    // Hand the socket to an I/O thread, or register it with the event backend
+    client->network = net;
+    client->index = net->client_count;
+    if (net->io) {
+        client->conn = io_pool_attach(net->io, fd);
     }
-
-    if (net->poll_count >= net->poll_capacity) {
-        net->poll_capacity *= 2;
-        net->poll_fds = realloc(net->poll_fds, net->poll_capacity * sizeof(struct pollfd));
+    if (net->io ? !client->conn : event_add_client(net, client) < 0) {
+        close(fd);
+        client_destroy(client);
+        return NULL;
     }
 
     // Add client
     net->clients[net->client_count++] = client;
-    net->poll_fds[net->poll_count].fd = fd;
-    net->poll_fds[net->poll_count].events = POLLIN;
-    net->poll_count++;
 
     // Send welcome message
-    client_send(client, "WELCOME\n");
+    client_send_literal(client, "WELCOME\n");
 
     return client;
 }
 
-static void network_disconnect_client(server_t *server, client_t *client)
+// Out of descriptors: free the spare one to accept and close the
+// pending connection, rather than wake up on it again and again.
+// io_uring keeps its listen sockets blocking, so a connection must be
+// waiting before accepting
+void network_shed_client(network_t *net, int listen_fd)
+{
+    struct pollfd pending = { .fd = listen_fd, .events = POLLIN };
+
+    if (net->spare_fd < 0 || poll(&pending, 1, 0) != 1) return;
+    log_error("Out of descriptors, shedding a connection");
+    close(net->spare_fd);
+    int fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd >= 0) {
+        close(fd);
+        net->stats.shed++;
+    }
+    net->spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+}
+
+// Accepts every pending connection, so that a burst of connects is
+// welcomed in one wakeup instead of one per loop iteration
+static void network_accept_clients(server_t *server, int listen_fd)
 {
     network_t *net = server->network;
-    
-    // Find client index
-    int index = -1;
-    for (int i = 0; i < net->client_count; i++) {
-        if (net->clients[i] == client) {
-            index = i;
-            break;
+
+    for (;;) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            network_add_client(server, fd);
+            continue;
+        }
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (errno == EMFILE || errno == ENFILE) {
+            network_shed_client(net, listen_fd);
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            log_error("Accept failed: %s", strerror(errno));
         }
+        return;
     }
+}
 
-    if (index < 0) return;
+static void network_disconnect_client(server_t *server, client_t *client)
+{
+    network_t *net = server->network;
+    int index = client->index;
 
     // Remove player if AI client
     if (client->type == CLIENT_AI && client->player_id >= 0) {
@@ -261,25 +426,49 @@ static void network_disconnect_client(server_t *server, client_t *client)
         }
     }
 
-    // Close and destroy
-    close(client->fd);
-    client_destroy(client);
+    // Drop its pending action and output
+    scheduler_remove(server->actions, &client->current_action.sched_index);
+    if (client->dirty_index >= 0) {
+        net->dirty[client->dirty_index] = NULL;
+    }
 
-    // Remove from arrays
-    for (int i = index; i < net->client_count - 1; i++) {
-        net->clients[i] = net->clients[i + 1];
+    if (client->shm) net->shm_count--;
+
+    // Unregister, close and destroy; an I/O thread or io_uring closes
+    // its own socket
+    if (client->conn) {
+        io_conn_release(client->conn);
+    } else if (client->uring_conn) {
+        event_remove_client(net, client);
+    } else {
+        event_remove_client(net, client);
+        close(client->fd);
     }
-    net->client_count--;
+    client_destroy(client);
 
-    // Remove from poll
-    for (int i = index + 1; i < net->poll_count - 1; i++) {
-        net->poll_fds[i] = net->poll_fds[i + 1];
+    // Swap the last client into the hole, as event_remove_client did
+    net->client_count--;
+    if (index < net->client_count) {
+        net->clients[index] = net->clients[net->client_count];
+        net->clients[index]->index = index;
     }
-    net->poll_count--;
 
     log_info("Client disconnected");
 }
 
+static void network_reap_clients(server_t *server)
+{
+    network_t *net = server->network;
+
+    // Disconnecting may queue more clients (failed GUI notifications)
+    while (net->closing) {
+        client_t *client = net->closing;
+        net->closing = client->closing_next;
+        if (!net->closing) net->closing_tail = NULL;
+        network_disconnect_client(server, client);
+    }
+}
+
 server_t *server_create(int argc, char **argv)
 {
     printf("DEBUG: Starting server_create\n");
@@ -334,7 +523,7 @@ server_t *server_create(int argc, char **argv)
     // Create network
     printf("DEBUG: Creating network on port %d\n", server->config->port);
     fflush(stdout);
-    server->network = network_create(server->config->port);
+    server->network = network_create(server->config);
     if (!server->network) {
         printf("ERROR: Failed to create network on port %d\n", server->config->port);
         log_error("Failed to create network on port %d", server->config->port);
@@ -344,15 +533,24 @@ server_t *server_create(int argc, char **argv)
     printf("DEBUG: Network created successfully\n");
     fflush(stdout);
 
+    // Create action scheduler
+    server->actions = scheduler_create();
+    if (!server->actions) {
+        log_error("Failed to create action scheduler");
+        server_destroy(server);
+        return NULL;
+    }
+
     server->running = true;
-    gettimeofday(&server->start_time, NULL);
-    gettimeofday(&server->last_tick, NULL);
-    server->tick_accumulator = 0.0;
+    server->tick = 0;
+    server->tick_base = 0;
+    server->clock_origin = time_now_us();
 
     printf("DEBUG: Server creation completed successfully\n");
-    log_info("Server created - Port: %d, Map: %dx%d, Teams: %d, Freq: %d",
+    log_info("Server created - Port: %d, Map: %dx%d, Teams: %d, Freq: %d, Backend: %s",
              server->config->port, server->config->width, server->config->height,
-             server->config->team_count, server->config->freq);
+             server->config->team_count, server->config->freq,
+             event_backend_name(server->config->backend));
 
     return server;
 }
@@ -361,6 +559,7 @@ void server_destroy(server_t *server)
 {
     if (!server) return;
 
+    if (server->actions) scheduler_destroy(server->actions);
     if (server->game) game_destroy(server->game);
     if (server->network) network_destroy(server->network);
     
@@ -377,93 +576,192 @@ void server_destroy(server_t *server)
     free(server);
 }
 
-static double get_time_diff(struct timeval *start, struct timeval *end)
+static uint64_t server_target_tick(server_t *server, uint64_t now)
 {
-    return (end->tv_sec - start->tv_sec) + (end->tv_usec - start->tv_usec) / 1000000.0;
+    return server->tick_base +
+        (now - server->clock_origin) * server->config->freq / 1000000;
+}
+
+void server_set_freq(server_t *server, int freq)
+{
+    // Rebase so ticks already elapsed keep their count
+    server->clock_origin = time_now_us();
+    server->tick_base = server->tick;
+    server->config->freq = freq;
 }
 
 static void process_completed_actions(server_t *server)
 {
-    for (int i = 0; i < server->network->client_count; i++) {
-        client_t *client = server->network->clients[i];
+    client_t *client;
+
+    // Only clients whose deadline has passed come out of the heap
+    while ((client = scheduler_pop_due(server->actions, server->tick)) != NULL) {
+        // Action completed, process next command
+        client->current_action.is_active = false;
+
+        client_command_done(client);
         
-        if (client->type == CLIENT_AI && client->current_action.is_active) {
-            if (client_action_done(client, server->config->freq)) {
-                // Action completed, process next command
-                client->current_action.is_active = false;
-                if (client->current_action.command) {
-                    free(client->current_action.command);
-                    client->current_action.command = NULL;
-                }
-                
-                client_command_done(client);
-                
-                // Execute next command if any
-                char *next = client_get_current_command(client);
-                if (next) {
-                    player_t *player = game_get_player_by_id(server->game, client->player_id);
-                    if (player && !player->is_dead) {
-                        command_execute(server, client, player, next);
-                    }
-                }
+        // Execute next command if any
+        const command_t *next = client_get_current_command(client);
+        if (next) {
+            player_t *player = game_get_player_by_id(server->game, client->player_id);
+            if (player) {
+                command_execute(server, client, player, next);
             }
         }
     }
 }
 
-int server_run(server_t *server)
+static int compute_timeout(server_t *server)
 {
-    log_info("Server running on port %d", server->config->port);
+    // Action deadlines fall on ticks, so the next tick is the next wake-up
+    uint64_t next = server->clock_origin +
+        ((server->tick + 1 - server->tick_base) * 1000000 + server->config->freq - 1) /
+        server->config->freq;
+    uint64_t now = time_now_us();
+
+    // Round up to whole milliseconds so we never wake up early
+    return next > now ? (int)((next - now + 999) / 1000) : 0;
+}
 
-    while (server->running) {
-        // Calculate timeout for next tick
-        double tick_duration = 1.0 / server->config->freq;
-        int timeout = (int)(tick_duration * 1000);
-        
-        // Poll network
-        int activity = poll(server->network->poll_fds, server->network->poll_count, timeout);
-        if (activity < 0) {
-            if (errno == EINTR) continue;
-            log_error("Poll error: %s", strerror(errno));
-            continue;
+static void server_advance_clock(server_t *server)
+{
+    uint64_t now = time_now_us();
+    uint64_t target = server_target_tick(server, now);
+
+    // After a stall or a clock jump, drop what is past the catch-up cap
+    // and rebase, so the loop still gets back to the network
+    if (target - server->tick > TICK_CATCHUP_MAX) {
+        log_info("Clock %llu ticks behind, skipping ahead",
+                 (unsigned long long)(target - server->tick));
+        target = server->tick + TICK_CATCHUP_MAX;
+        server->clock_origin = now;
+        server->tick_base = target;
+    }
+
+    // Catch up every tick we fell behind, in order
+    while (server->running && server->tick < target) {
+        server->tick++;
+        game_tick(server->game);
+
+        // Check victory
+        if (game_check_victory(server->game)) {
+            gui_notify_game_end(server, server->game->winning_team);
+            log_info("Game won by team %s!", server->game->winning_team);
+            server->running = false;
         }
 
+        // Process completed actions
+        process_completed_actions(server);
+    }
+}
+
+// Sockets owned by this thread: wait, then dispatch only the ready ones
+static void server_handle_events(server_t *server, int timeout)
+{
+    int ready = event_wait(server->network, timeout);
+    if (ready < 0) {
+        if (errno != EINTR) log_error("Poll error: %s", strerror(errno));
+        return;
+    }
+
+    for (int i = 0; i < ready; i++) {
+        event_ready_t *ev = &server->network->ready[i];
+
         // Handle new connections
-        if (server->network->poll_fds[0].revents & POLLIN) {
-            network_accept_client(server);
+        if (!ev->data) {
+            network_accept_clients(server, ev->fd);
+            continue;
         }
 
-        // Handle client data
-        for (int i = 0; i < server->network->client_count; i++) {
-            client_t *client = server->network->clients[i];
-            if (server->network->poll_fds[i + 1].revents & POLLIN) {
-                network_process_client_data(server, client);
+        client_t *client = ev->data;
+        if (client->closing) continue;
+
+        // Flush pending output
+        if (ev->flags & EVENT_WRITE) {
+            bool was_paused = client->paused;
+            if (!network_flush_client(client)) {
+                client_close(client);
+                continue;
             }
+            // Input left in the socket while paused gets no new edge
+            if (was_paused && !client->paused) ev->flags |= EVENT_READ;
         }
 
-        // Game tick
-        struct timeval now;
-        gettimeofday(&now, NULL);
-        double elapsed = get_time_diff(&server->last_tick, &now);
-        server->tick_accumulator += elapsed * server->config->freq;
-        server->last_tick = now;
-
-        if (server->tick_accumulator >= 1.0) {
-            server->tick_accumulator -= 1.0;
-            game_tick(server->game, server->config->freq);
-            
-            // Check victory
-            if (game_check_victory(server->game)) {
-                gui_notify_game_end(server, server->game->winning_team);
-                log_info("Game won by team %s!", server->game->winning_team);
-                server->running = false;
+        // Handle client data
+        if (ev->flags & (EVENT_READ | EVENT_HUP)) {
+            if (!network_process_client_data(server, client)) {
+                client_close(client);
             }
         }
+    }
+}
 
-        // Process completed actions
-        process_completed_actions(server);
+// io_uring: one enter submits the sends queued last iteration and waits,
+// completions carry accepted sockets and received bytes
+static void server_handle_uring(server_t *server, int timeout)
+{
+    if (uring_dispatch(server, timeout) < 0) {
+        log_error("io_uring error: %s", strerror(errno));
+    }
+}
+
+// Sockets owned by I/O threads: only accepting happens here, input
+// arrives split into lines and decoded
+static void server_handle_io_threads(server_t *server, int timeout)
+{
+    network_t *net = server->network;
+
+    int ready = io_pool_wait(net->io, net->listen_fds, net->listen_count, timeout);
+    if (ready < 0) {
+        if (errno != EINTR) log_error("Poll error: %s", strerror(errno));
+        return;
+    }
+    for (int i = 0; i < net->listen_count; i++) {
+        if (ready & (1 << i)) network_accept_clients(server, net->listen_fds[i]);
+    }
+    network_process_conns(server);
+}
+
+int server_run(server_t *server)
+{
+    network_t *net = server->network;
+
+    log_info("Server running on port %d", server->config->port);
+    if (net->unix_path) log_info("Server running on unix:%s", net->unix_path);
+
+    while (server->running) {
+        // Sleep until the next game tick or network activity
+        int timeout = compute_timeout(server);
+        if (net->shm_count > 0) timeout = network_shm_timeout(server, timeout);
+        if (net->io) {
+            server_handle_io_threads(server, timeout);
+        } else if (net->uring) {
+            server_handle_uring(server, timeout);
+        } else {
+            server_handle_events(server, timeout);
+        }
+        if (net->shm_count > 0) network_process_shm(server);
+
+        // Advance the game clock
+        server_advance_clock(server);
+
+        // Disconnect clients closed during this iteration
+        network_reap_clients(server);
+
+        // Send everything queued during this iteration
+        network_flush_pending(net);
+        if (net->io) io_pool_wake(net->io);
     }
 
+    if (net->io) {
+        io_pool_stop(net->io);
+        net->stats.syscalls += io_pool_syscalls(net->io);
+    }
+    if (net->uring) net->stats.syscalls += net->uring->enters;
+    log_info("Output: %llu lines in %llu send syscalls",
+             (unsigned long long)net->stats.messages,
+             (unsigned long long)net->stats.syscalls);
     log_info("Server shutting down");
     return 0;
 }
@@ -0,0 +1,222 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Shared-memory transport implementation
+*/
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include "shm.h"
+#include "client.h"
+#include "msg.h"
+#include "uring.h"
+
+// Rings start on their own page after the header
+#define SHM_DATA_OFFSET 4096
+
+bool shm_is_request(const char *line, size_t len)
+{
+    return len == 3 && memcmp(line, "SHM", 3) == 0;
+}
+
+// Sends "SHM <size>\n" with both descriptors, behind the output still
+// queued (WELCOME) so that the client reads things in order
+static bool shm_send_handshake(client_t *client, int memfd, int event_fd)
+{
+    struct iovec iov[OUTBUF_MAX_IOV + 1];
+    size_t total = 0;
+    int count = 0;
+
+    for (out_chunk_t *c = client->output.head; c && count < OUTBUF_MAX_IOV; c = c->next) {
+        if (c->end == c->start) continue;
+        iov[count].iov_base = c->data + c->start;
+        iov[count].iov_len = c->end - c->start;
+        total += iov[count++].iov_len;
+    }
+    if (total != client->output.size) return false;
+
+    char line[8 + MSG_INT_SIZE];
+    msg_t reply;
+    msg_init(&reply, line, sizeof(line));
+    msg_literal(&reply, "SHM ");
+    msg_int(&reply, SHM_RING_SIZE);
+    msg_char(&reply, '\n');
+    iov[count].iov_base = line;
+    iov[count++].iov_len = reply.len;
+    total += reply.len;
+
+    int fds[2] = { memfd, event_fd };
+    union {
+        char buf[CMSG_SPACE(sizeof(fds))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr msg = {0};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    client->network->stats.syscalls++;
+    if (sendmsg(client->fd, &msg, MSG_NOSIGNAL) != (ssize_t)total) return false;
+    outbuf_consume(&client->output, client->output.size);
+    return true;
+}
+
+// Gives a client on the Unix socket its rings. NULL when it cannot
+// have them: the caller answers ko and the socket keeps working
+shm_conn_t *shm_attach(client_t *client)
+{
+    int domain = 0;
+    socklen_t domain_len = sizeof(domain);
+
+    // Not with I/O threads, which own the socket, nor behind a send in flight
+    if (client->conn || (client->uring_conn && client->uring_conn->sending) ||
+        getsockopt(client->fd, SOL_SOCKET, SO_DOMAIN, &domain, &domain_len) < 0 ||
+        domain != AF_UNIX) {
+        return NULL;
+    }
+
+    shm_conn_t *shm = calloc(1, sizeof(shm_conn_t));
+    if (!shm) return NULL;
+    shm->size = SHM_DATA_OFFSET + 2 * (size_t)SHM_RING_SIZE;
+    shm->event_fd = -1;
+
+    // Sealed at its size before the client gets it: a client shrinking
+    // the file would make the server's next access raise SIGBUS
+    int memfd = memfd_create("zappy-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0 || ftruncate(memfd, shm->size) < 0 ||
+        fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+        if (memfd >= 0) close(memfd);
+        free(shm);
+        return NULL;
+    }
+    shm->header = mmap(NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (shm->header == MAP_FAILED) {
+        close(memfd);
+        free(shm);
+        return NULL;
+    }
+
+    // The memfd starts zeroed: indices and flags are already 0
+    shm_header_t *header = shm->header;
+    header->magic = SHM_MAGIC;
+    header->version = SHM_VERSION;
+    header->ring_size = SHM_RING_SIZE;
+    header->data_offset = SHM_DATA_OFFSET;
+    shm->to_server = (char *)header + SHM_DATA_OFFSET;
+    shm->to_client = shm->to_server + SHM_RING_SIZE;
+
+    shm->event_fd = eventfd(0, EFD_CLOEXEC);
+    if (shm->event_fd < 0 || !shm_send_handshake(client, memfd, shm->event_fd)) {
+        close(memfd);
+        shm_detach(shm);
+        return NULL;
+    }
+    close(memfd);
+    return shm;
+}
+
+void shm_detach(shm_conn_t *shm)
+{
+    if (!shm) return;
+
+    munmap(shm->header, shm->size);
+    if (shm->event_fd >= 0) close(shm->event_fd);
+    free(shm);
+}
+
+// Moves what the client wrote into the input buffer, as much as fits.
+// invalid is set if the client's index makes no sense
+size_t shm_read(shm_conn_t *shm, inbuf_t *in, bool *invalid)
+{
+    shm_header_t *header = shm->header;
+    uint64_t tail = atomic_load_explicit(&header->to_server.tail, memory_order_acquire);
+    uint64_t used = tail - shm->input_head;
+
+    if (used > SHM_RING_SIZE) {
+        *invalid = true;
+        return 0;
+    }
+
+    size_t offset = shm->input_head & (SHM_RING_SIZE - 1);
+    size_t first = SHM_RING_SIZE - offset;
+    if (first > used) first = used;
+
+    size_t copied = inbuf_append(in, shm->to_server + offset, first);
+    if (copied == first && used > first) {
+        copied += inbuf_append(in, shm->to_server, used - first);
+    }
+
+    shm->input_head += copied;
+    atomic_store_explicit(&header->to_server.head, shm->input_head, memory_order_release);
+    return copied;
+}
+
+// As many bytes as fit, published at once
+size_t shm_write(shm_conn_t *shm, const char *data, size_t len)
+{
+    shm_header_t *header = shm->header;
+    uint64_t head = atomic_load_explicit(&header->to_client.head, memory_order_acquire);
+    uint64_t used = shm->output_tail - head;
+
+    // A bogus head reads as a full ring: output then backs up to the limit
+    if (used >= SHM_RING_SIZE) return 0;
+    if (len > SHM_RING_SIZE - used) len = SHM_RING_SIZE - used;
+
+    size_t offset = shm->output_tail & (SHM_RING_SIZE - 1);
+    size_t first = SHM_RING_SIZE - offset;
+    if (first > len) first = len;
+    memcpy(shm->to_client + offset, data, first);
+    memcpy(shm->to_client, data + first, len - first);
+
+    shm->output_tail += len;
+    atomic_store_explicit(&header->to_client.tail, shm->output_tail, memory_order_release);
+    return len;
+}
+
+bool shm_output_full(shm_conn_t *shm)
+{
+    uint64_t head = atomic_load_explicit(&shm->header->to_client.head, memory_order_acquire);
+
+    return shm->output_tail - head >= SHM_RING_SIZE;
+}
+
+// After changing a ring: the client sees the change, or its flag is
+// seen here and it gets woken. Returns true if that took a syscall
+bool shm_wake_client(shm_conn_t *shm)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!atomic_load_explicit(&shm->header->client_waiting, memory_order_relaxed) ||
+        !atomic_exchange_explicit(&shm->header->client_waiting, 0, memory_order_relaxed)) {
+        return false;
+    }
+    eventfd_write(shm->event_fd, 1);
+    return true;
+}
+
+bool shm_sleep(shm_conn_t *shm)
+{
+    shm_header_t *header = shm->header;
+
+    atomic_store_explicit(&header->server_waiting, 1, memory_order_seq_cst);
+    return atomic_load_explicit(&header->to_server.tail, memory_order_seq_cst) == shm->input_head;
+}
+
+void shm_awake(shm_conn_t *shm)
+{
+    atomic_store_explicit(&shm->header->server_waiting, 0, memory_order_relaxed);
+}
@@ -0,0 +1,124 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Single-producer single-consumer byte ring implementation
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "spsc.h"
+
+bool spsc_init(spsc_ring_t *ring, size_t capacity)
+{
+    ring->data = malloc(capacity);
+    if (!ring->data) return false;
+
+    ring->capacity = capacity;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return true;
+}
+
+void spsc_destroy(spsc_ring_t *ring)
+{
+    free(ring->data);
+    ring->data = NULL;
+}
+
+// Copy len bytes in at position pos, wrapping at the end of data
+static void spsc_copy_in(spsc_ring_t *ring, size_t pos, const void *data, size_t len)
+{
+    size_t offset = pos & (ring->capacity - 1);
+    size_t first = ring->capacity - offset;
+
+    if (first > len) first = len;
+    memcpy(ring->data + offset, data, first);
+    memcpy(ring->data, (const char *)data + first, len - first);
+}
+
+size_t spsc_free_space(spsc_ring_t *ring)
+{
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    return ring->capacity - (tail - head);
+}
+
+// As many bytes as fit, published at once
+size_t spsc_write(spsc_ring_t *ring, const void *data, size_t len)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t room = spsc_free_space(ring);
+
+    if (len > room) len = room;
+    if (len == 0) return 0;
+    spsc_copy_in(ring, tail, data, len);
+    atomic_store_explicit(&ring->tail, tail + len, memory_order_release);
+    return len;
+}
+
+// A header and its payload as one record, or nothing if they do not fit
+bool spsc_push(spsc_ring_t *ring, const void *header, size_t header_len,
+               const void *data, size_t len)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    if (header_len + len > spsc_free_space(ring)) return false;
+    spsc_copy_in(ring, tail, header, header_len);
+    spsc_copy_in(ring, tail + header_len, data, len);
+    atomic_store_explicit(&ring->tail, tail + header_len + len, memory_order_release);
+    return true;
+}
+
+size_t spsc_used(spsc_ring_t *ring)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    return tail - head;
+}
+
+// Readable bytes as up to two contiguous spans, for writev
+int spsc_peek(spsc_ring_t *ring, struct iovec iov[2])
+{
+    size_t used = spsc_used(ring);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t offset = head & (ring->capacity - 1);
+    size_t first = ring->capacity - offset;
+
+    if (used == 0) return 0;
+    if (first >= used) {
+        iov[0].iov_base = ring->data + offset;
+        iov[0].iov_len = used;
+        return 1;
+    }
+    iov[0].iov_base = ring->data + offset;
+    iov[0].iov_len = first;
+    iov[1].iov_base = ring->data;
+    iov[1].iov_len = used - first;
+    return 2;
+}
+
+// Copies out and consumes up to len bytes
+size_t spsc_read(spsc_ring_t *ring, void *data, size_t len)
+{
+    size_t used = spsc_used(ring);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t offset = head & (ring->capacity - 1);
+    size_t first = ring->capacity - offset;
+
+    if (len > used) len = used;
+    if (first > len) first = len;
+    memcpy(data, ring->data + offset, first);
+    memcpy((char *)data + first, ring->data, len - first);
+    atomic_store_explicit(&ring->head, head + len, memory_order_release);
+    return len;
+}
+
+void spsc_consume(spsc_ring_t *ring, size_t len)
+{
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    atomic_store_explicit(&ring->head, head + len, memory_order_release);
+}
@@ -19,7 +19,6 @@ team_t *team_create(int id, const char *name, int max_clients)
     team->max_clients = max_clients;
     team->egg_count = 0;
     team->connected_clients = 0;
-    team->eggs = NULL;
 
     return team;
 }
@@ -28,14 +27,7 @@ void team_destroy(team_t *team)
 {
     if (!team) return;
 
-    // Free eggs
-    egg_t *egg = team->eggs;
-    while (egg) {
-        egg_t *next = egg->next;
-        free(egg);
-        egg = next;
-    }
-
+    free(team->egg_ids);
     free(team->name);
     free(team);
 }
@@ -45,48 +37,39 @@ int team_available_slots(team_t *team)
     return team->egg_count;
 }
 
-egg_t *team_add_egg(team_t *team, int egg_id, int x, int y)
+bool team_add_egg(team_t *team, egg_t *egg)
 {
-    egg_t *egg = calloc(1, sizeof(egg_t));
-    if (!egg) return NULL;
-
-    egg->id = egg_id;
-    egg->team_id = team->id;
-    egg->x = x;
-    egg->y = y;
-    egg->next = team->eggs;
-    team->eggs = egg;
-    team->egg_count++;
+    if (team->egg_count >= team->egg_capacity) {
+        int capacity = team->egg_capacity ? team->egg_capacity * 2 : 16;
+        int *egg_ids = realloc(team->egg_ids, capacity * sizeof(int));
+        if (!egg_ids) return false;
+        team->egg_ids = egg_ids;
+        team->egg_capacity = capacity;
+    }
 
-    return egg;
+    egg->team_index = team->egg_count;
+    team->egg_ids[team->egg_count++] = egg->id;
+    return true;
 }
 
-void team_remove_egg(team_t *team, int egg_id)
+void team_remove_egg(team_t *team, egg_pool_t *pool, egg_t *egg)
 {
-    egg_t **current = &team->eggs;
-    
-    while (*current) {
-        if ((*current)->id == egg_id) {
-            egg_t *to_remove = *current;
-            *current = (*current)->next;
-            free(to_remove);
-            team->egg_count--;
-            return;
-        }
-        current = &(*current)->next;
+    int index = egg->team_index;
+    if (index < 0 || index >= team->egg_count) return;
+
+    // Swap the last egg into the hole
+    team->egg_count--;
+    if (index < team->egg_count) {
+        int moved = team->egg_ids[team->egg_count];
+        team->egg_ids[index] = moved;
+        egg_pool_get(pool, moved)->team_index = index;
     }
+    egg->team_index = -1;
 }
 
-egg_t *team_get_random_egg(team_t *team)
+// Egg id, or -1 when the team has none
+int team_get_random_egg(team_t *team)
 {
-    if (!team->eggs || team->egg_count == 0) return NULL;
-
-    int index = rand() % team->egg_count;
-    egg_t *egg = team->eggs;
-    
-    for (int i = 0; i < index && egg; i++) {
-        egg = egg->next;
-    }
-    
-    return egg;
-}
\ No newline at end of file
+    if (team->egg_count == 0) return -1;
+    return team->egg_ids[rand() % team->egg_count];
+}
@@ -0,0 +1,549 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** io_uring network backend implementation
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include "uring.h"
+#include "client.h"
+#include "network.h"
+
+// Request kinds, in the low bits of user_data above the connection (or
+// the listen socket index for accepts)
+#define URING_ACCEPT 1
+#define URING_RECV 2
+#define URING_SEND 3
+#define URING_CANCEL 4
+#define URING_LISTEN_POLL 5
+#define URING_KIND_MASK 7
+#define URING_KIND_BITS 3
+
+static int uring_setup(unsigned entries, struct io_uring_params *params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_register(int fd, unsigned opcode, void *arg, unsigned count)
+{
+    return syscall(__NR_io_uring_register, fd, opcode, arg, count);
+}
+
+// Publishes the prepared entries, submits them and waits for at least
+// one completion or timeout milliseconds (-1: no limit)
+static int uring_enter(uring_t *uring, int timeout, bool wait)
+{
+    struct __kernel_timespec ts = {0};
+    struct io_uring_getevents_arg arg = {0};
+    unsigned flags = IORING_ENTER_EXT_ARG;
+    unsigned head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned submit = uring->sq_local_tail - head;
+
+    __atomic_store_n(uring->sq_tail, uring->sq_local_tail, __ATOMIC_RELEASE);
+    if (wait) {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (timeout >= 0) {
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (long long)(timeout % 1000) * 1000000;
+            arg.ts = (uint64_t)(uintptr_t)&ts;
+        }
+    }
+    if (submit > 0) uring->enters++;
+    return syscall(__NR_io_uring_enter, uring->fd, submit, wait ? 1 : 0,
+                   flags, &arg, sizeof(arg));
+}
+
+static struct io_uring_sqe *uring_get_sqe(uring_t *uring)
+{
+    // Full: hand what is queued to the kernel first
+    unsigned head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+    if (uring->sq_local_tail - head >= uring->sq_entries) {
+        uring_enter(uring, 0, false);
+    }
+
+    struct io_uring_sqe *sqe = &uring->sqes[uring->sq_local_tail & uring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    uring->sq_local_tail++;
+    return sqe;
+}
+
+// Gives a receive buffer back to the kernel
+static void uring_recycle(uring_t *uring, int bid)
+{
+    // Field by field: the ring tail overlays resv of the first entry
+    struct io_uring_buf *buf = &uring->buf_ring->bufs[uring->buf_tail & (URING_BUFFERS - 1)];
+    buf->addr = (uint64_t)(uintptr_t)(uring->buffers + (size_t)bid * URING_BUFFER_SIZE);
+    buf->len = URING_BUFFER_SIZE;
+    buf->bid = bid;
+    uring->buf_tail++;
+    __atomic_store_n(&uring->buf_ring->tail, uring->buf_tail, __ATOMIC_RELEASE);
+    uring->buf_free++;
+}
+
+static void uring_arm_accept(uring_t *uring, int index)
+{
+    struct io_uring_sqe *sqe = uring_get_sqe(uring);
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = uring->listen_fds[index];
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = ((uint64_t)index << URING_KIND_BITS) | URING_ACCEPT;
+    uring->accepting[index] = true;
+}
+
+// Waits for a connection without taking a descriptor, unlike an accept
+static void uring_arm_listen_poll(uring_t *uring, int index)
+{
+    struct io_uring_sqe *sqe = uring_get_sqe(uring);
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = uring->listen_fds[index];
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = ((uint64_t)index << URING_KIND_BITS) | URING_LISTEN_POLL;
+    uring->accepting[index] = true;
+}
+
+static void uring_arm_recv(uring_t *uring, uring_conn_t *conn)
+{
+    // Without free buffers it would fail at once: wait for a recycle
+    if (uring->buf_free == 0) {
+        if (!conn->starved) uring->starved++;
+        conn->starved = true;
+        return;
+    }
+    if (conn->starved) uring->starved--;
+    conn->starved = false;
+
+    struct io_uring_sqe *sqe = uring_get_sqe(uring);
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = conn->fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUFFER_GROUP;
+    sqe->user_data = (uintptr_t)conn | URING_RECV;
+    conn->receiving = true;
+    conn->inflight++;
+}
+
+static void uring_cancel_recv(uring_t *uring, uring_conn_t *conn)
+{
+    struct io_uring_sqe *sqe = uring_get_sqe(uring);
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = (uintptr_t)conn | URING_RECV;
+    sqe->user_data = (uintptr_t)conn | URING_CANCEL;
+    conn->canceling = true;
+    conn->inflight++;
+}
+
+static void uring_stash_clear(uring_t *uring, uring_conn_t *conn)
+{
+    while (conn->stash_count > 0) {
+        int bid = conn->stash_head;
+        conn->stash_head = uring->buf_next[bid];
+        conn->stash_count--;
+        uring_recycle(uring, bid);
+    }
+    conn->stash_offset = 0;
+}
+
+static void uring_conn_free(uring_t *uring, uring_conn_t *conn)
+{
+    if (conn->prev) {
+        conn->prev->next = conn->next;
+    } else {
+        uring->conns = conn->next;
+    }
+    if (conn->next) conn->next->prev = conn->prev;
+    if (conn->starved) uring->starved--;
+
+    uring_stash_clear(uring, conn);
+    outbuf_clear(&conn->orphan);
+    close(conn->fd);
+    free(conn);
+}
+
+// Stashed input into the client's buffer and through the command code,
+// until the stash is empty or output backs up
+static void uring_client_input(server_t *server, uring_t *uring, uring_conn_t *conn)
+{
+    client_t *client = conn->client;
+
+    for (;;) {
+        network_process_lines(server, client);
+
+        // Switched to shared memory: the socket only carries wake-ups
+        if (client->shm) {
+            uring_stash_clear(uring, conn);
+            break;
+        }
+
+        // The stash can hold far more than a socket read: check the
+        // backlog as it builds instead of once per iteration
+        if (!client->closing && client->output.size > server->network->output_hwm &&
+            !network_flush_client(client)) {
+            client_close(client);
+        }
+        if (client->paused || client->closing || conn->stash_count == 0) break;
+
+        int bid = conn->stash_head;
+        const char *data = uring->buffers + (size_t)bid * URING_BUFFER_SIZE;
+        conn->stash_offset += inbuf_append(&client->input, data + conn->stash_offset,
+                                           uring->buf_len[bid] - conn->stash_offset);
+        if (conn->stash_offset == uring->buf_len[bid]) {
+            conn->stash_head = uring->buf_next[bid];
+            conn->stash_count--;
+            conn->stash_offset = 0;
+            uring_recycle(uring, bid);
+        }
+    }
+
+    if (client->closing) return;
+    if (conn->eof && conn->stash_count == 0) {
+        client_close(client);
+        return;
+    }
+
+    // Backpressure: a paused client stops receiving once it holds enough
+    if (client->paused) {
+        if (conn->receiving && !conn->canceling && conn->stash_count >= URING_STASH_MAX) {
+            uring_cancel_recv(uring, conn);
+        }
+    } else if (!conn->receiving && !conn->eof) {
+        uring_arm_recv(uring, conn);
+    }
+}
+
+static void uring_on_recv(server_t *server, uring_t *uring, uring_conn_t *conn,
+                          struct io_uring_cqe *cqe)
+{
+    if (cqe->res > 0 && (cqe->flags & IORING_CQE_F_BUFFER)) {
+        int bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+        uring->buf_free--;
+        if (conn->client && !conn->client->shm && !conn->eof) {
+            // Appended to the stash, chained through buf_next
+            uring->buf_len[bid] = cqe->res;
+            uring->buf_next[bid] = -1;
+            if (conn->stash_count > 0) {
+                uring->buf_next[conn->stash_tail] = bid;
+            } else {
+                conn->stash_head = bid;
+            }
+            conn->stash_tail = bid;
+            conn->stash_count++;
+        } else {
+            uring_recycle(uring, bid);
+        }
+    } else if (cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+        // End of stream or socket error
+        conn->eof = true;
+    }
+
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        conn->receiving = false;
+        conn->inflight--;
+    }
+    if (!conn->client) {
+        if (conn->inflight == 0) uring_conn_free(uring, conn);
+        return;
+    }
+    uring_client_input(server, uring, conn);
+}
+
+static void uring_on_send(server_t *server, uring_t *uring, uring_conn_t *conn,
+                          struct io_uring_cqe *cqe)
+{
+    client_t *client = conn->client;
+
+    conn->sending = false;
+    conn->inflight--;
+    if (!client) {
+        outbuf_clear(&conn->orphan);
+        if (conn->inflight == 0) uring_conn_free(uring, conn);
+        return;
+    }
+    if (client->closing) return;
+
+    if (cqe->res < 0) {
+        client_close(client);
+        return;
+    }
+
+    // Queue the rest, then resume input if the backlog went down
+    outbuf_consume(&client->output, cqe->res);
+    if (!network_flush_client(client)) {
+        client_close(client);
+        return;
+    }
+    if (!client->paused) uring_client_input(server, uring, conn);
+}
+
+static void uring_on_cancel(uring_t *uring, uring_conn_t *conn)
+{
+    conn->canceling = false;
+    conn->inflight--;
+    if (!conn->client && conn->inflight == 0) uring_conn_free(uring, conn);
+}
+
+static void uring_on_accept(server_t *server, uring_t *uring, struct io_uring_cqe *cqe)
+{
+    int index = cqe->user_data >> URING_KIND_BITS;
+
+    if (!(cqe->flags & IORING_CQE_F_MORE)) uring->accepting[index] = false;
+    if (cqe->res >= 0) {
+        network_add_client(server, cqe->res);
+    } else if ((cqe->res == -EMFILE || cqe->res == -ENFILE) && !uring->accepting[index]) {
+        // The accept takes its descriptor before any connection comes,
+        // so re-armed now it would fail at once on every loop. Shed the
+        // waiting connection, then accept again once another arrives
+        network_shed_client(server->network, uring->listen_fds[index]);
+        uring_arm_listen_poll(uring, index);
+    }
+}
+
+static void uring_on_listen_poll(uring_t *uring, struct io_uring_cqe *cqe)
+{
+    // uring_dispatch re-arms the accept
+    uring->accepting[cqe->user_data >> URING_KIND_BITS] = false;
+}
+
+uring_t *uring_create(const int *listen_fds, int listen_count)
+{
+    uring_t *uring = calloc(1, sizeof(uring_t));
+    if (!uring) return NULL;
+    uring->fd = -1;
+    memcpy(uring->listen_fds, listen_fds, listen_count * sizeof(int));
+    uring->listen_count = listen_count;
+
+    // Completions are only run when the loop asks for them; older
+    // kernels get a plain ring
+    struct io_uring_params params = {0};
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER |
+                   IORING_SETUP_DEFER_TASKRUN;
+    params.cq_entries = URING_CQ_ENTRIES;
+    uring->fd = uring_setup(URING_ENTRIES, &params);
+    if (uring->fd < 0) {
+        memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = URING_CQ_ENTRIES;
+        uring->fd = uring_setup(URING_ENTRIES, &params);
+    }
+    if (uring->fd < 0 || !(params.features & IORING_FEAT_SINGLE_MMAP) ||
+        !(params.features & IORING_FEAT_EXT_ARG)) {
+        uring_destroy(uring);
+        return NULL;
+    }
+
+    // One mapping holds both rings
+    size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    uring->ring_size = sq_size > cq_size ? sq_size : cq_size;
+    uring->ring = mmap(NULL, uring->ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, uring->fd, IORING_OFF_SQ_RING);
+    uring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring->sqes = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, uring->fd, IORING_OFF_SQES);
+    if (uring->ring == MAP_FAILED || uring->sqes == MAP_FAILED) {
+        if (uring->ring == MAP_FAILED) uring->ring = NULL;
+        if (uring->sqes == MAP_FAILED) uring->sqes = NULL;
+        uring_destroy(uring);
+        return NULL;
+    }
+
+    char *ring = uring->ring;
+    uring->sq_head = (unsigned *)(ring + params.sq_off.head);
+    uring->sq_tail = (unsigned *)(ring + params.sq_off.tail);
+    uring->sq_mask = *(unsigned *)(ring + params.sq_off.ring_mask);
+    uring->sq_entries = params.sq_entries;
+    uring->sq_local_tail = *uring->sq_tail;
+    unsigned *sq_array = (unsigned *)(ring + params.sq_off.array);
+    for (unsigned i = 0; i < params.sq_entries; i++) sq_array[i] = i;
+    uring->cq_head = (unsigned *)(ring + params.cq_off.head);
+    uring->cq_tail = (unsigned *)(ring + params.cq_off.tail);
+    uring->cq_mask = *(unsigned *)(ring + params.cq_off.ring_mask);
+    uring->cqes = (struct io_uring_cqe *)(ring + params.cq_off.cqes);
+
+    // Provided receive buffers, picked by the kernel per completion
+    uring->buf_ring_size = URING_BUFFERS * sizeof(struct io_uring_buf);
+    uring->buf_ring = mmap(NULL, uring->buf_ring_size, PROT_READ | PROT_WRITE,
+                           MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    uring->buffers = malloc((size_t)URING_BUFFERS * URING_BUFFER_SIZE);
+    if (uring->buf_ring == MAP_FAILED || !uring->buffers) {
+        if (uring->buf_ring == MAP_FAILED) uring->buf_ring = NULL;
+        uring_destroy(uring);
+        return NULL;
+    }
+
+    struct io_uring_buf_reg reg = {0};
+    reg.ring_addr = (uint64_t)(uintptr_t)uring->buf_ring;
+    reg.ring_entries = URING_BUFFERS;
+    reg.bgid = URING_BUFFER_GROUP;
+    if (uring_register(uring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        uring_destroy(uring);
+        return NULL;
+    }
+    for (int bid = 0; bid < URING_BUFFERS; bid++) uring_recycle(uring, bid);
+
+    for (int i = 0; i < listen_count; i++) uring_arm_accept(uring, i);
+    return uring;
+}
+
+// Closing the ring cancels whatever is still in flight
+void uring_destroy(uring_t *uring)
+{
+    if (!uring) return;
+
+    if (uring->fd >= 0) close(uring->fd);
+    if (uring->ring) munmap(uring->ring, uring->ring_size);
+    if (uring->sqes) munmap(uring->sqes, uring->sqes_size);
+    if (uring->buf_ring) munmap(uring->buf_ring, uring->buf_ring_size);
+
+    while (uring->conns) {
+        uring_conn_t *conn = uring->conns;
+        uring->conns = conn->next;
+        outbuf_clear(&conn->orphan);
+        close(conn->fd);
+        free(conn);
+    }
+    free(uring->buffers);
+    free(uring);
+}
+
+int uring_add_client(uring_t *uring, client_t *client)
+{
+    uring_conn_t *conn = calloc(1, sizeof(uring_conn_t));
+    if (!conn) return -1;
+
+    conn->fd = client->fd;
+    conn->client = client;
+    conn->stash_head = -1;
+    conn->stash_tail = -1;
+    conn->next = uring->conns;
+    if (uring->conns) uring->conns->prev = conn;
+    uring->conns = conn;
+
+    client->uring_conn = conn;
+    uring_arm_recv(uring, conn);
+    return 0;
+}
+
+// The client is going away. Its socket is shut down so that pending
+// requests complete, and closed once the last one has
+void uring_remove_client(uring_t *uring, client_t *client)
+{
+    uring_conn_t *conn = client->uring_conn;
+
+    client->uring_conn = NULL;
+    conn->client = NULL;
+    uring_stash_clear(uring, conn);
+
+    // A sendmsg in flight still points into the output chunks
+    if (conn->sending) {
+        conn->orphan = client->output;
+        memset(&client->output, 0, sizeof(client->output));
+    }
+
+    if (conn->inflight == 0) {
+        uring_conn_free(uring, conn);
+        return;
+    }
+    shutdown(conn->fd, SHUT_RDWR);
+}
+
+// Queues one sendmsg over the client's pending output chunks; the rest
+// goes when it completes. Submitted with everything else on the next
+// uring_dispatch
+void uring_send(uring_t *uring, client_t *client)
+{
+    uring_conn_t *conn = client->uring_conn;
+    int count = 0;
+
+    if (conn->sending || client->output.size == 0) return;
+
+    for (out_chunk_t *c = client->output.head; c && count < OUTBUF_MAX_IOV; c = c->next) {
+        if (c->end == c->start) continue;
+        conn->iov[count].iov_base = c->data + c->start;
+        conn->iov[count].iov_len = c->end - c->start;
+        count++;
+    }
+    if (count == 0) return;
+
+    memset(&conn->msg, 0, sizeof(conn->msg));
+    conn->msg.msg_iov = conn->iov;
+    conn->msg.msg_iovlen = count;
+
+    struct io_uring_sqe *sqe = uring_get_sqe(uring);
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = conn->fd;
+    sqe->addr = (uintptr_t)&conn->msg;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = (uintptr_t)conn | URING_SEND;
+    conn->sending = true;
+    conn->inflight++;
+}
+
+// One io_uring_enter per loop iteration: submits the sends and re-arms
+// queued since the last call, then waits for completions or the tick
+int uring_dispatch(server_t *server, int timeout)
+{
+    uring_t *uring = server->network->uring;
+    int handled = 0;
+
+    for (int i = 0; i < uring->listen_count; i++) {
+        if (!uring->accepting[i]) uring_arm_accept(uring, i);
+    }
+
+    int ret = uring_enter(uring, timeout, true);
+    if (ret < 0 && errno != ETIME && errno != EINTR && errno != EBUSY) {
+        return -1;
+    }
+
+    unsigned head = *uring->cq_head;
+    unsigned tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        // Copied out: handlers may queue requests that reuse the slot
+        struct io_uring_cqe cqe = uring->cqes[head & uring->cq_mask];
+        __atomic_store_n(uring->cq_head, ++head, __ATOMIC_RELEASE);
+        handled++;
+
+        uring_conn_t *conn = (uring_conn_t *)(uintptr_t)(cqe.user_data & ~(uint64_t)URING_KIND_MASK);
+        switch (cqe.user_data & URING_KIND_MASK) {
+        case URING_ACCEPT:
+            uring_on_accept(server, uring, &cqe);
+            break;
+        case URING_RECV:
+            uring_on_recv(server, uring, conn, &cqe);
+            break;
+        case URING_SEND:
+            uring_on_send(server, uring, conn, &cqe);
+            break;
+        case URING_CANCEL:
+            uring_on_cancel(uring, conn);
+            break;
+        case URING_LISTEN_POLL:
+            uring_on_listen_poll(uring, &cqe);
+            break;
+        }
+
+        if (head == tail) tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+    }
+
+    // Receives that ran out of buffers, now that some came back
+    if (uring->starved > 0 && uring->buf_free > 0) {
+        for (uring_conn_t *conn = uring->conns; conn && uring->buf_free > 0; conn = conn->next) {
+            if (conn->starved && conn->client && !conn->client->paused) {
+                uring_arm_recv(uring, conn);
+            }
+        }
+    }
+    return handled;
+}
@@ -10,6 +10,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdarg.h>
+#include <time.h>
 #include "utils.h"
 
 char *str_trim(char *str)
@@ -79,6 +80,18 @@ int str_array_len(char **array)
     return len;
 }
 
+uint32_t str_hash(const char *str)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 void log_info(const char *format, ...)
 {
     va_list args;
@@ -116,6 +129,13 @@ void log_debug(const char *format, ...)
 #endif
 }
 
+uint64_t time_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 void die(const char *format, ...)
 {
     va_list args;
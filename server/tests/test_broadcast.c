@@ -0,0 +1,104 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Broadcast direction test
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "broadcast.h"
+#include "server.h"
+
+server_t *g_server = NULL;
+
+// The direction as computed before the integer octant: the angle from
+// the receiver to the sender, rounded to the nearest multiple of 45
+static int reference_direction(player_t *sender, player_t *receiver,
+                               int map_width, int map_height)
+{
+    if (sender->x == receiver->x && sender->y == receiver->y) {
+        return 0;
+    }
+
+    int dx = sender->x - receiver->x;
+    int dy = sender->y - receiver->y;
+
+    if (abs(dx) > map_width / 2) {
+        dx = dx > 0 ? dx - map_width : dx + map_width;
+    }
+    if (abs(dy) > map_height / 2) {
+        dy = dy > 0 ? dy - map_height : dy + map_height;
+    }
+
+    double angle = atan2(dy, dx) * 180.0 / M_PI;
+    angle = fmod(angle + 360.0, 360.0);
+    int octant = (int)((angle + 22.5) / 45.0) % 8;
+    int orientation_offset = (receiver->orientation - NORTH) * 2;
+
+    return (octant - orientation_offset + 8) % 8 + 1;
+}
+
+// Every sender/receiver pair in every orientation on a width x height map
+static int check_map(int width, int height)
+{
+    player_t sender = {0};
+    player_t receiver = {0};
+    int failures = 0;
+
+    for (int orientation = NORTH; orientation <= WEST; orientation++) {
+        receiver.orientation = orientation;
+        for (int i = 0; i < width * height * width * height; i++) {
+            sender.x = i % width;
+            sender.y = i / width % height;
+            receiver.x = i / (width * height) % width;
+            receiver.y = i / (width * height * width);
+
+            int got = broadcast_get_direction(&sender, &receiver, width, height);
+            int want = reference_direction(&sender, &receiver, width, height);
+            if (got != want && failures++ < 8) {
+                fprintf(stderr, "%dx%d: (%d,%d) -> (%d,%d) facing %d: got %d, want %d\n",
+                        width, height, sender.x, sender.y, receiver.x, receiver.y,
+                        orientation, got, want);
+            }
+        }
+    }
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    // Odd and even sides, square and not, including 1-wide maps where
+    // every offset wraps to 0 along that axis
+    for (int width = 1; width <= 17; width++) {
+        for (int height = 1; height <= 17; height++) {
+            failures += check_map(width, height);
+        }
+    }
+
+    // Same tile, and the diagonals where the old angle was exactly 45
+    player_t a = {.x = 3, .y = 3, .orientation = NORTH};
+    player_t b = {.x = 3, .y = 3, .orientation = NORTH};
+    if (broadcast_get_direction(&a, &b, 10, 10) != 0) failures++;
+    for (int d = 1; d <= 4; d++) {
+        a.x = 3 + d;
+        a.y = 3 + d;
+        if (broadcast_get_direction(&a, &b, 10, 10) != 2) failures++;
+        a.x = 3 - d;
+        if (broadcast_get_direction(&a, &b, 10, 10) != 4) failures++;
+        a.y = 3 - d;
+        if (broadcast_get_direction(&a, &b, 10, 10) != 6) failures++;
+        a.x = 3 + d;
+        if (broadcast_get_direction(&a, &b, 10, 10) != 8) failures++;
+    }
+
+    if (failures) {
+        fprintf(stderr, "test_broadcast: %d failures\n", failures);
+        return 1;
+    }
+    printf("test_broadcast: ok\n");
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Inventory drop on starvation test
+*/
+
+#include <stdio.h>
+#include "game.h"
+#include "server.h"
+
+server_t *g_server = NULL;
+
+// Starves a new player on a tile holding tile_food units, with no
+// respawn in between: the drop must leave the ground food unchanged
+static int check_drop(int tile_food)
+{
+    char *teams[] = {"team"};
+    game_t *game = game_create(4, 4, teams, 1, 1);
+    player_t *player = game_add_player(game, 1, "team");
+    int id = player->id;
+    tile_t *tile = map_get_tile(game->map, player->x, player->y);
+    int failures = 0;
+
+    map_remove_resource(game->map, tile, RES_FOOD, tile->resources[RES_FOOD]);
+    map_add_resource(game->map, tile, RES_FOOD, tile_food);
+    int64_t total = game->map->totals[RES_FOOD];
+
+    while (game_get_player_by_id(game, id)) {
+        game->resource_timer = 0;
+        game_tick(game);
+    }
+
+    if (tile->resources[RES_FOOD] != tile_food ||
+        game->map->totals[RES_FOOD] != total) {
+        fprintf(stderr, "tile with %d food: tile food=%d total food=%lld, want %d and %lld\n",
+                tile_food, tile->resources[RES_FOOD],
+                (long long)game->map->totals[RES_FOOD], tile_food, (long long)total);
+        failures++;
+    }
+    game_destroy(game);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = check_drop(0) + check_drop(3);
+
+    if (failures) {
+        fprintf(stderr, "test_death_drop: %d failures\n", failures);
+        return 1;
+    }
+    printf("test_death_drop: ok\n");
+    return 0;
+}